@@ -0,0 +1,216 @@
+// Throughput benchmarks for scale.
+// Prints one CSV row per case to stdout so results can be collected and trended over time.
+// Usage: bench [min_seconds_per_case]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "../scale.h"
+
+using namespace cc0::scale;
+
+namespace
+{
+	/// @brief A processor that does almost nothing, used to measure the overhead of iteration alone.
+	/// @tparam dimensions The number of dimensions.
+	template < uint32_t dimensions >
+	class touch
+	{
+	private:
+		uint32_t &m_sum; // Receives a value depending on every index so the loop is not optimized away.
+
+	public:
+		/// @brief Creates a new touch object.
+		/// @param sum Receives a value depending on every index.
+		explicit touch(uint32_t &sum) : m_sum(sum) {}
+
+		/// @brief Touches an element.
+		/// @param dst The destination index.
+		/// @param src The source index.
+		void operator()(const Point<int32_t,dimensions> &dst, const Point<fixed32_t,dimensions> &src) const
+		{
+			m_sum += uint32_t(dst[0]) ^ uint32_t(src[0].value_bits);
+		}
+	};
+
+	/// @brief A ratio between the source and destination sizes.
+	struct Ratio
+	{
+		const char *name; // The name of the ratio.
+		int32_t     num;  // The numerator of the source size relative to the destination size.
+		int32_t     den;  // The denominator of the source size relative to the destination size.
+		bool        flip; // Determines if the destination is reversed along axis 0.
+	};
+
+	const Ratio RATIOS[] = {
+		{ "identity", 1, 1, false },
+		{ "flip",     1, 1, true  },
+		{ "up2",      1, 2, false },
+		{ "down2",    2, 1, false },
+		{ "up1.6",    5, 8, false },
+		{ "down1.6",  8, 5, false }
+	};
+
+	/// @brief Returns the name of an element type.
+	template < typename type_t > const char *type_name( void );
+	template <> const char *type_name<uint8_t>( void )  { return "uint8"; }
+	template <> const char *type_name<uint16_t>( void ) { return "uint16"; }
+	template <> const char *type_name<float>( void )    { return "float"; }
+
+	/// @brief Returns the destination length along every axis for a given number of dimensions. Chosen so that all source coordinates fit in fixed32_t.
+	template < uint32_t dimensions > int32_t extent( void );
+	template <> int32_t extent<1>( void ) { return 16384; }
+	template <> int32_t extent<2>( void ) { return 1024; }
+	template <> int32_t extent<3>( void ) { return 96; }
+
+	/// @brief Repeatedly runs a function until a minimum amount of time has passed.
+	/// @return The number of seconds per run.
+	template < typename function_t >
+	double measure(const function_t &function, double min_seconds)
+	{
+		typedef std::chrono::steady_clock clock;
+		function(); // Warm up caches and page in memory.
+		uint64_t runs = 0;
+		const clock::time_point start = clock::now();
+		double elapsed = 0.0;
+		do {
+			function();
+			++runs;
+			elapsed = std::chrono::duration<double>(clock::now() - start).count();
+		} while (elapsed < min_seconds);
+		return elapsed / double(runs);
+	}
+
+	/// @brief Runs and reports all cases for a given element type and number of dimensions.
+	template < typename type_t, uint32_t dimensions >
+	void run(double min_seconds)
+	{
+		const int32_t length = extent<dimensions>();
+		for (const Ratio &ratio : RATIOS) {
+			Point<int32_t,dimensions> dst_stride, src_stride;
+			Area<int32_t,dimensions>  dst_area;
+			Area<fixed32_t,dimensions> src_area;
+			size_t dst_count = 1, src_count = 1;
+			for (uint32_t i = 0; i < dimensions; ++i) {
+				const int32_t src_length = length * ratio.num / ratio.den;
+				dst_stride[i] = int32_t(dst_count);
+				src_stride[i] = int32_t(src_count);
+				dst_count *= size_t(length);
+				src_count *= size_t(src_length);
+				dst_area.a[i] = 0;
+				dst_area.b[i] = length;
+				src_area.a[i] = fixed32_t(0);
+				src_area.b[i] = fixed32_t(src_length);
+			}
+			if (ratio.flip) {
+				dst_area.a[0] = length;
+				dst_area.b[0] = 0;
+			}
+			std::vector<type_t> dst(dst_count), src(src_count);
+			for (size_t i = 0; i < src_count; ++i) {
+				src[i] = type_t(i * 2654435761u);
+			}
+			for (int masked = 0; masked < 2; ++masked) {
+				Area<int32_t,dimensions> dst_mask;
+				uint64_t elements = 1;
+				for (uint32_t i = 0; i < dimensions; ++i) {
+					const int32_t inset = masked ? length / 8 : 0;
+					dst_mask.a[i] = inset;
+					dst_mask.b[i] = length - inset;
+					elements *= uint64_t(length - 2 * inset);
+				}
+				const write<type_t,type_t,dimensions> writer(dst.data(), dst_stride, src.data(), src_stride);
+				uint32_t sum = 0;
+				const touch<dimensions> toucher(sum);
+				const double write_seconds = measure([&]() { scale(dst_area, src_area, writer, dst_mask); }, min_seconds);
+				const double touch_seconds = measure([&]() { scale(dst_area, src_area, toucher, dst_mask); }, min_seconds);
+				const struct { const char *name; double seconds; uint64_t bytes; } results[] = {
+					{ "write", write_seconds, elements * 2 * sizeof(type_t) },
+					{ "touch", touch_seconds, 0 }
+				};
+				for (const auto &result : results) {
+					std::printf("%u,%s,%s,%s,%s,%llu,%.9f,%.0f,%.0f\n", dimensions, ratio.name, masked ? "masked" : "unmasked", type_name<type_t>(), result.name, (unsigned long long)elements, result.seconds, double(elements) / result.seconds, double(result.bytes) / result.seconds);
+				}
+				if (sum == 0x12345678u) { std::printf("#\n"); } // Keeps the touch results observable.
+			}
+		}
+	}
+
+	/// @brief Runs and reports batches of small quads scattered over the destination, such as the sprites of a compositor, scaled with one call to scale per quad and with a single call to scale_batch.
+	template < typename type_t >
+	void run_quads(double min_seconds)
+	{
+		static constexpr int32_t  LENGTH   = 1024; // The destination length along both axes.
+		static constexpr int32_t  TEXTURE  = 64;   // The source length along both axes.
+		static constexpr uint32_t COUNT    = 4096; // The number of quads per batch.
+		const Point<int32_t,2> dst_stride = { 1, LENGTH };
+		const Point<int32_t,2> src_stride = { 1, TEXTURE };
+		std::vector<type_t> dst(size_t(LENGTH) * LENGTH), src(size_t(TEXTURE) * TEXTURE);
+		for (size_t i = 0; i < src.size(); ++i) {
+			src[i] = type_t(i * 2654435761u);
+		}
+		const Area<int32_t,2> dst_mask = { { 0, 0 }, { LENGTH, LENGTH } };
+		const write<type_t,type_t,2> writer(dst.data(), dst_stride, src.data(), src_stride);
+		for (int32_t size = 8; size <= 64; size *= 2) {
+			std::vector< Area<int32_t,2> >   dst_areas(COUNT);
+			std::vector< Area<fixed32_t,2> > src_areas(COUNT);
+			std::vector< ScalePlan<2> >      plans(COUNT);
+			uint32_t seed = 12345;
+			uint64_t elements = 0;
+			for (uint32_t i = 0; i < COUNT; ++i) {
+				Area<int32_t,2> clipped;
+				for (uint32_t j = 0; j < 2; ++j) {
+					seed = seed * 1664525u + 1013904223u;
+					dst_areas[i].a[j] = int32_t(seed >> 8) % (LENGTH + size) - size;
+					dst_areas[i].b[j] = dst_areas[i].a[j] + size;
+					seed = seed * 1664525u + 1013904223u;
+					src_areas[i].a[j] = fixed32_t(0);
+					src_areas[i].b[j] = fixed32_t(int32_t(seed >> 8) % (TEXTURE - 3) + 4);
+				}
+				if (cc0::scale::internal::clip(dst_areas[i], dst_mask, clipped)) {
+					elements += cc0::scale::internal::volume(clipped);
+				}
+			}
+			// The difference is small next to the time spent writing, so both are timed in alternating rounds and the fastest round of each is kept.
+			double loop_seconds = 0.0, batch_seconds = 0.0;
+			for (int round = 0; round < 5; ++round) {
+				const double loop = measure([&]() {
+					for (uint32_t i = 0; i < COUNT; ++i) {
+						scale(dst_areas[i], src_areas[i], writer, dst_mask);
+					}
+				}, min_seconds / 5);
+				const double batch = measure([&]() { scale_batch(dst_areas.data(), src_areas.data(), COUNT, writer, dst_mask, plans.data()); }, min_seconds / 5);
+				loop_seconds  = round == 0 || loop < loop_seconds ? loop : loop_seconds;
+				batch_seconds = round == 0 || batch < batch_seconds ? batch : batch_seconds;
+			}
+			const struct { const char *name; double seconds; } results[] = {
+				{ "write_loop",  loop_seconds },
+				{ "write_batch", batch_seconds }
+			};
+			for (const auto &result : results) {
+				std::printf("2,quads%dx%d,masked,%s,%s,%llu,%.9f,%.0f,%.0f\n", size, size, type_name<type_t>(), result.name, (unsigned long long)elements, result.seconds, double(elements) / result.seconds, double(elements * 2 * sizeof(type_t)) / result.seconds);
+			}
+		}
+	}
+
+	/// @brief Runs and reports all cases for a given element type.
+	template < typename type_t >
+	void run_all(double min_seconds)
+	{
+		run<type_t,1>(min_seconds);
+		run<type_t,2>(min_seconds);
+		run<type_t,3>(min_seconds);
+		run_quads<type_t>(min_seconds);
+	}
+}
+
+int main(int argc, char **argv)
+{
+	const double min_seconds = argc > 1 ? std::atof(argv[1]) : 0.25;
+	std::printf("dimensions,ratio,mask,type,processor,elements,seconds,elements_per_second,bytes_per_second\n");
+	run_all<uint8_t>(min_seconds);
+	run_all<uint16_t>(min_seconds);
+	run_all<float>(min_seconds);
+	return 0;
+}
@@ -0,0 +1,1130 @@
+// Differential checks and benchmarks for the fast paths of scale.
+// Runs every specialized path against a plain scalar traversal sampling with the same filter, over random areas, masks, ratios, and flipped axes in 1 to 4 dimensions, and prints one CSV row per path with the number of mismatching cases and the speedup over the scalar traversal.
+// Also checks that batched entry points reject arrays that are too small, coordinates near the limits of their types, fixed-point formats other than fixed32_t, and moved-from scale_async handles, which are reported on stderr, and times scale_work_stealing against scale_parallel on a processor whose cost varies across the destination.
+// When the OpenCL headers are installed, also checks opencl_scaler against write and write_linear on the first OpenCL device, if any, and must then be linked with -lOpenCL.
+// Usage: oracle [cases_per_path] [min_seconds_per_timing] [seed]
+// Exits with a non-zero status if any path mismatched.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <thread>
+#include <vector>
+#include "../scale.h"
+#include "../scale_thread.h"
+#if defined(__has_include)
+	#if __has_include(<CL/cl.h>) || __has_include(<OpenCL/opencl.h>)
+		#define ORACLE_OPENCL
+		#include <cmath>
+		#include <limits>
+		#include "../scale_opencl.h"
+	#endif
+#endif
+
+using namespace cc0::scale;
+
+namespace
+{
+	/// @brief A processor that copies single elements, which makes scale use the plain scalar traversal. This is the reference all other paths are checked against.
+	/// @tparam type_t The type of the arrays.
+	/// @tparam dimensions The number of dimensions.
+	template < typename type_t, uint32_t dimensions >
+	class reference
+	{
+	private:
+		type_t                    *m_dst;        // The destination array.
+		const type_t              *m_src;        // The source array.
+		Point<int32_t,dimensions>  m_dst_stride; // The number of destination elements between two adjacent indices on each axis.
+		Point<int32_t,dimensions>  m_src_stride; // The number of source elements between two adjacent indices on each axis.
+
+	public:
+		/// @brief Creates a new reference object.
+		reference(type_t *dst, const Point<int32_t,dimensions> &dst_stride, const type_t *src, const Point<int32_t,dimensions> &src_stride) : m_dst(dst), m_src(src), m_dst_stride(dst_stride), m_src_stride(src_stride) {}
+
+		/// @brief Copies an element.
+		/// @param dst The destination index.
+		/// @param src The source index.
+		void operator()(const Point<int32_t,dimensions> &dst, const Point<fixed32_t,dimensions> &src) const
+		{
+			int32_t d = 0, s = 0;
+			for (uint32_t i = 0; i < dimensions; ++i) {
+				d += dst[i] * m_dst_stride[i];
+				s += int32_t(src[i]) * m_src_stride[i];
+			}
+			m_dst[d] = m_src[s];
+		}
+	};
+
+	/// @brief A processor that box filters single elements, the scalar reference of write_box. Every element is averaged from the source elements it covers, weighted by coverage, without the whole-block path and the stepping of write_box.
+	/// @tparam type_t The type of the arrays.
+	/// @tparam dimensions The number of dimensions.
+	template < typename type_t, uint32_t dimensions >
+	class box_reference
+	{
+	private:
+		type_t                     *m_dst;        // The destination array.
+		const type_t               *m_src;        // The source array.
+		Point<int32_t,dimensions>   m_dst_stride; // The number of destination elements between two adjacent indices on each axis.
+		Point<int32_t,dimensions>   m_src_stride; // The number of source elements between two adjacent indices on each axis.
+		Point<int32_t,dimensions>   m_src_size;   // The number of source elements along each axis.
+		Point<fixed32_t,dimensions> m_src_delta;  // The delta used to iterate through the source index.
+
+	public:
+		/// @brief Creates a new box_reference object.
+		box_reference(type_t *dst, const Point<int32_t,dimensions> &dst_stride, const type_t *src, const Point<int32_t,dimensions> &src_stride, const Point<int32_t,dimensions> &src_size, const Point<fixed32_t,dimensions> &src_delta) : m_dst(dst), m_src(src), m_dst_stride(dst_stride), m_src_stride(src_stride), m_src_size(src_size), m_src_delta(src_delta) {}
+
+		/// @brief Filters an element.
+		/// @param dst The destination index.
+		/// @param src The source index.
+		void operator()(const Point<int32_t,dimensions> &dst, const Point<fixed32_t,dimensions> &src) const
+		{
+			internal::box_span span[dimensions];
+			int32_t d = 0;
+			for (uint32_t i = 0; i < dimensions; ++i) {
+				span[i].set(src[i], m_src_delta[i]);
+				d += dst[i] * m_dst_stride[i];
+			}
+			m_dst[d] = internal::filtered<type_t>::from(internal::box_sample(m_src, m_src_stride, m_src_size, span));
+		}
+	};
+
+	/// @brief A processor that linearly interpolates single elements, the scalar reference of write_linear. Computes the weights of every axis for each element on its own rather than stepping them along runs, but sums the corners in the same order.
+	/// @tparam type_t The type of the arrays.
+	/// @tparam dimensions The number of dimensions.
+	template < typename type_t, uint32_t dimensions >
+	class linear_reference
+	{
+	private:
+		static constexpr uint32_t CORNERS = uint32_t(1) << (dimensions - 1); // The number of source elements interpolated between along the outer axes.
+
+		type_t                     *m_dst;        // The destination array.
+		const type_t               *m_src;        // The source array.
+		Point<int32_t,dimensions>   m_dst_stride; // The number of destination elements between two adjacent indices on each axis.
+		Point<int32_t,dimensions>   m_src_stride; // The number of source elements between two adjacent indices on each axis.
+		Point<int32_t,dimensions>   m_src_size;   // The number of source elements along each axis.
+		Point<fixed32_t,dimensions> m_src_delta;  // The delta used to iterate through the source index.
+
+	public:
+		/// @brief Creates a new linear_reference object.
+		linear_reference(type_t *dst, const Point<int32_t,dimensions> &dst_stride, const type_t *src, const Point<int32_t,dimensions> &src_stride, const Point<int32_t,dimensions> &src_size, const Point<fixed32_t,dimensions> &src_delta) : m_dst(dst), m_src(src), m_dst_stride(dst_stride), m_src_stride(src_stride), m_src_size(src_size), m_src_delta(src_delta) {}
+
+		/// @brief Interpolates an element.
+		/// @param dst The destination index.
+		/// @param src The source index.
+		void operator()(const Point<int32_t,dimensions> &dst, const Point<fixed32_t,dimensions> &src) const
+		{
+			int32_t offset[CORNERS];
+			float   weight[CORNERS];
+			offset[0] = 0;
+			weight[0] = 1.0f;
+			uint32_t corners = 1;
+			for (uint32_t i = 1; i < dimensions; ++i) {
+				internal::linear_taps taps;
+				taps.set(src[i], m_src_delta[i], m_src_size[i], m_src_stride[i]);
+				for (uint32_t c = 0; c < corners; ++c) {
+					offset[c + corners] = offset[c] + taps.offset[1];
+					weight[c + corners] = weight[c] * taps.weight[1];
+					offset[c] += taps.offset[0];
+					weight[c] *= taps.weight[0];
+				}
+				corners *= 2;
+			}
+			internal::linear_taps taps;
+			taps.set(src[0], m_src_delta[0], m_src_size[0], m_src_stride[0]);
+			float sum = 0.0f;
+			for (uint32_t c = 0; c < CORNERS; ++c) {
+				const type_t *in = m_src + offset[c];
+				sum += weight[c] * (float(in[taps.offset[0]]) + (float(in[taps.offset[1]]) - float(in[taps.offset[0]])) * taps.weight[1]);
+			}
+			int32_t d = 0;
+			for (uint32_t i = 0; i < dimensions; ++i) {
+				d += dst[i] * m_dst_stride[i];
+			}
+			m_dst[d] = internal::filtered<type_t>::from(sum);
+		}
+	};
+
+	/// @brief A processor that filters single 2D elements along axis 0 and then along axis 1, the scalar reference of scale_separable. Filters the source rows of every element on their own rather than caching them, but sums in the same order.
+	/// @tparam filter_t The filter.
+	/// @tparam type_t The type of the arrays.
+	template < typename filter_t, typename type_t >
+	class separable_reference
+	{
+	private:
+		type_t             *m_dst;        // The destination array.
+		const type_t       *m_src;        // The source array.
+		Point<int32_t,2>    m_dst_stride; // The number of destination elements between two adjacent indices on each axis.
+		Point<int32_t,2>    m_src_stride; // The number of source elements between two adjacent indices on each axis.
+		Point<int32_t,2>    m_src_size;   // The number of source elements along each axis.
+		Point<fixed32_t,2>  m_src_delta;  // The delta used to iterate through the source index.
+
+	public:
+		/// @brief Creates a new separable_reference object.
+		separable_reference(type_t *dst, const Point<int32_t,2> &dst_stride, const type_t *src, const Point<int32_t,2> &src_stride, const Point<int32_t,2> &src_size, const Point<fixed32_t,2> &src_delta) : m_dst(dst), m_src(src), m_dst_stride(dst_stride), m_src_stride(src_stride), m_src_size(src_size), m_src_delta(src_delta) {}
+
+		/// @brief Filters an element.
+		/// @param dst The destination index.
+		/// @param src The source index.
+		void operator()(const Point<int32_t,2> &dst, const Point<fixed32_t,2> &src) const
+		{
+			typename filter_t::span span_x, span_y;
+			span_x.set(src[0], m_src_delta[0]);
+			span_y.set(src[1], m_src_delta[1]);
+			float sum = 0.0f;
+			for (int32_t j = span_y.first; j <= span_y.last; ++j) {
+				const type_t *in = m_src + internal::clamp_index(j, m_src_size[1]) * m_src_stride[1];
+				float row = 0.0f;
+				for (int32_t k = span_x.first; k <= span_x.last; ++k) {
+					row += span_x.weight(k) * float(in[internal::clamp_index(k, m_src_size[0]) * m_src_stride[0]]);
+				}
+				sum += span_y.weight(j) * row;
+			}
+			m_dst[dst[0] * m_dst_stride[0] + dst[1] * m_dst_stride[1]] = internal::filtered<type_t>::from(sum);
+		}
+	};
+
+	/// @brief A processor that converts single pixels with write_pixels, which makes scale use the plain scalar traversal rather than handing write_pixels entire rows.
+	/// @tparam dimensions The number of dimensions.
+	template < uint32_t dimensions >
+	class pixel_reference
+	{
+	private:
+		write_pixels<bgra8,rgba8,dimensions> m_pixels; // The conversion.
+
+	public:
+		/// @brief Creates a new pixel_reference object.
+		pixel_reference(uint32_t *dst, const Point<int32_t,dimensions> &dst_stride, const uint32_t *src, const Point<int32_t,dimensions> &src_stride) : m_pixels(dst, dst_stride, src, src_stride) {}
+
+		/// @brief Converts a pixel.
+		/// @param dst The destination index.
+		/// @param src The source index.
+		void operator()(const Point<int32_t,dimensions> &dst, const Point<fixed32_t,dimensions> &src) const
+		{
+			m_pixels(dst, src);
+		}
+	};
+
+	/// @brief A row processor that copies rows with write, but blocks for a while on the rows of the first eighth of the destination, like a processor paging in its source. Used to time scale_work_stealing against scale_parallel when the cost varies across the destination.
+	class uneven
+	{
+	private:
+		write<uint32_t,uint32_t,2> m_write; // The copy.
+		int32_t                    m_slow;  // The rows before this one block.
+
+	public:
+		/// @brief Creates a new uneven object.
+		uneven(uint32_t *dst, const Point<int32_t,2> &dst_stride, const uint32_t *src, const Point<int32_t,2> &src_stride, int32_t slow) : m_write(dst, dst_stride, src, src_stride), m_slow(slow) {}
+
+		/// @brief Copies a row, blocking first if it is one of the slow rows.
+		void operator()(const Point<int32_t,2> &dst, const Point<fixed32_t,2> &src, const Point<fixed32_t,2> &src_delta, int32_t count) const
+		{
+			if (dst[1] < m_slow) { std::this_thread::sleep_for(std::chrono::microseconds(200)); }
+			m_write(dst, src, src_delta, count);
+		}
+	};
+
+	/// @brief A reader for the streamed traversal policy that does nothing.
+	struct no_reader
+	{
+		/// @brief Does nothing.
+		void operator()(int32_t, int32_t) const {}
+	};
+
+	/// @brief The scalar references paths are checked against, one per filter.
+	enum class sampling
+	{
+		nearest,    // Copies the nearest source element, like write.
+		box,        // Averages the covered source elements, like write_box.
+		exact,      // Copies the nearest source element while stepping the source index without drift, like scale_exact.
+		linear,     // Interpolates between the nearest source elements, like write_linear.
+		separable,  // Interpolates along axis 0 and then axis 1, like scale_separable with linear_filter. Only 2D.
+		pixels,     // Swizzles the nearest source pixel from rgba8 to bgra8, like write_pixels. Only uint32.
+		planes,     // Copies the nearest source element with one traversal per plane, first the element reference and then write, like planes.
+		subsampled  // Copies the nearest source element at a lower resolution, like subsample with write.
+	};
+
+	/// @brief The paths checked against the reference.
+	enum class path
+	{
+		rows,          // write as a row processor, using the SIMD and constant-ratio kernels.
+		streaming,     // write with non-temporal stores.
+		tables,        // write fed from precomputed index tables.
+		tiled,         // The tiled traversal policy.
+		morton,        // The tiled traversal policy in Morton order.
+		sparse,        // The sparse traversal policy with every cell occupied.
+		streamed,      // The streamed traversal policy.
+		parallel,      // scale_parallel on a thread pool.
+		work_stealing, // scale_work_stealing on a thread pool.
+		async,         // scale_async on a thread pool.
+		box,           // write_box as a row processor, including its whole-block path.
+		exact,         // scale_exact with write as a row processor.
+		static_areas,  // scale with areas known at compile-time.
+		batch,         // scale_batch over several pairs of areas.
+		binned,        // bin_batch and scale_binned over several pairs of areas on a thread pool.
+		in_place,      // The in_place traversal policy scaling an array into itself.
+		linear,        // write_linear as a row processor.
+		separable,     // scale_separable with linear_filter.
+		pixels,        // write_pixels as a row processor, using the SIMD kernels of write.
+		planes,        // planes driving the element reference and then write from one traversal.
+		subsampled     // subsample driving write as a row processor.
+	};
+
+	const struct { path id; const char *name; sampling reference; } PATHS[] = {
+		{ path::rows,          "rows",          sampling::nearest    },
+		{ path::streaming,     "streaming",     sampling::nearest    },
+		{ path::tables,        "tables",        sampling::nearest    },
+		{ path::tiled,         "tiled",         sampling::nearest    },
+		{ path::morton,        "morton",        sampling::nearest    },
+		{ path::sparse,        "sparse",        sampling::nearest    },
+		{ path::streamed,      "streamed",      sampling::nearest    },
+		{ path::parallel,      "parallel",      sampling::nearest    },
+		{ path::work_stealing, "work_stealing", sampling::nearest    },
+		{ path::async,         "async",         sampling::nearest    },
+		{ path::box,           "box",           sampling::box        },
+		{ path::exact,         "exact",         sampling::exact      },
+		{ path::static_areas,  "static",        sampling::nearest    },
+		{ path::batch,         "batch",         sampling::nearest    },
+		{ path::binned,        "binned",        sampling::nearest    },
+		{ path::in_place,      "in_place",      sampling::nearest    },
+		{ path::linear,        "linear",        sampling::linear     },
+		{ path::separable,     "separable",     sampling::separable  },
+		{ path::pixels,        "pixels",        sampling::pixels     },
+		{ path::planes,        "planes",        sampling::planes     },
+		{ path::subsampled,    "subsampled",    sampling::subsampled }
+	};
+
+	/// @brief Returns the name of an element type.
+	template < typename type_t > const char *type_name( void );
+	template <> const char *type_name<uint8_t>( void )  { return "uint8"; }
+	template <> const char *type_name<uint16_t>( void ) { return "uint16"; }
+	template <> const char *type_name<uint32_t>( void ) { return "uint32"; }
+
+	/// @brief Returns the largest array length along every axis of random cases for a given number of dimensions.
+	template < uint32_t dimensions > int32_t random_extent( void );
+	template <> int32_t random_extent<1>( void ) { return 300; }
+	template <> int32_t random_extent<2>( void ) { return 48; }
+	template <> int32_t random_extent<3>( void ) { return 16; }
+	template <> int32_t random_extent<4>( void ) { return 8; }
+
+	/// @brief Returns the destination length along every axis of timed cases for a given number of dimensions. Chosen so that all source coordinates fit in fixed32_t.
+	template < uint32_t dimensions > int32_t timed_extent( void );
+	template <> int32_t timed_extent<1>( void ) { return 16384; }
+	template <> int32_t timed_extent<2>( void ) { return 1024; }
+	template <> int32_t timed_extent<3>( void ) { return 96; }
+	template <> int32_t timed_extent<4>( void ) { return 24; }
+
+	/// @brief The arrays and areas of a single case.
+	/// @tparam type_t The type of the arrays.
+	/// @tparam dimensions The number of dimensions.
+	template < typename type_t, uint32_t dimensions >
+	struct Case
+	{
+		Point<int32_t,dimensions>                 dst_size;   // The number of destination elements along each axis.
+		Point<int32_t,dimensions>                 dst_stride; // The number of destination elements between two adjacent indices on each axis.
+		Point<int32_t,dimensions>                 src_stride; // The number of source elements between two adjacent indices on each axis.
+		Point<int32_t,dimensions>                 src_size;   // The number of source elements along each axis covered by source areas.
+		Area<int32_t,dimensions>                  dst_area;   // The destination area. Axes may be reversed.
+		Area<fixed32_t,dimensions>                src_area;   // The source area. Axes may be reversed.
+		Area<int32_t,dimensions>                  dst_mask;   // The destination mask, inside of the destination array. Axes may be reversed.
+		std::vector<type_t>                       src;        // The source array, with one extra element along each axis.
+		std::vector<type_t>                       dst;        // The destination array.
+		std::vector< Area<int32_t,dimensions> >   dst_areas;  // The destination areas of all pairs scaled by batched paths, starting with dst_area. Empty for other paths.
+		std::vector< Area<fixed32_t,dimensions> > src_areas;  // The source areas of all pairs scaled by batched paths, starting with src_area.
+		Point<int32_t,dimensions>                 factor;     // The subsampling factor along each axis of subsampled paths.
+		uint32_t                                  variant;    // The static areas of static paths.
+		int32_t                                   tile_size;  // The length of each tile along every axis of binned paths.
+
+		/// @brief Creates an empty case that is not subsampled.
+		Case( void ) : variant(0), tile_size(1)
+		{
+			for (uint32_t i = 0; i < dimensions; ++i) {
+				factor[i] = 1;
+			}
+		}
+
+		/// @brief Allocates the arrays and fills the source with a pattern.
+		void allocate( void )
+		{
+			size_t dst_count = 1, src_count = 1;
+			for (uint32_t i = 0; i < dimensions; ++i) {
+				dst_stride[i] = int32_t(dst_count);
+				src_stride[i] = int32_t(src_count);
+				dst_count *= size_t(dst_size[i]);
+				src_count *= size_t(src_size[i] + 1);
+			}
+			src.resize(src_count);
+			for (size_t i = 0; i < src_count; ++i) {
+				src[i] = type_t((i + 1) * 2654435761u);
+			}
+			dst.assign(dst_count, type_t(0x5a5a5a5au));
+		}
+
+		/// @brief Creates a random case.
+		/// @param rng The random number generator.
+		void randomize(std::mt19937 &rng)
+		{
+			const int32_t extent = random_extent<dimensions>();
+			const bool    blocks = rng() % 4 == 0;
+			for (uint32_t i = 0; i < dimensions; ++i) {
+				dst_size[i] = 1 + int32_t(rng() % uint32_t(extent));
+				src_size[i] = 1 + int32_t(rng() % uint32_t(extent));
+				const int32_t span = dst_size[i] * 2;
+				dst_area.a[i] = int32_t(rng() % uint32_t(span)) - dst_size[i] / 2;
+				dst_area.b[i] = int32_t(rng() % uint32_t(span)) - dst_size[i] / 2;
+				if (dst_area.a[i] == dst_area.b[i]) { ++dst_area.b[i]; }
+				dst_mask.a[i] = int32_t(rng() % uint32_t(dst_size[i] + 1));
+				dst_mask.b[i] = int32_t(rng() % uint32_t(dst_size[i] + 1));
+				if (rng() % 4 == 0) { // Unmasked axes are common and hit the fast paths of whole rows.
+					dst_mask.a[i] = 0;
+					dst_mask.b[i] = dst_size[i];
+				}
+				const uint32_t bits = uint32_t(src_size[i]) << 15;
+				const bool whole = rng() % 2 == 0; // Whole source elements produce exact integer and power-of-two ratios.
+				src_area.a[i].value_bits = int32_t(whole ? (rng() % uint32_t(src_size[i] + 1)) << 15 : rng() % (bits + 1));
+				src_area.b[i].value_bits = int32_t(whole ? (rng() % uint32_t(src_size[i] + 1)) << 15 : rng() % (bits + 1));
+				if (src_area.a[i].value_bits == src_area.b[i].value_bits) { src_area.b[i] = src_area.a[i] == fixed32_t(0) ? fixed32_t(src_size[i]) : fixed32_t(0); }
+				if (rng() % 8 == 0) { // Exact 2x stretches and shrinks of the destination area.
+					const int32_t length = dst_area.b[i] - dst_area.a[i];
+					src_area.a[i] = fixed32_t(0);
+					src_area.b[i].value_bits = internal::min(length < 0 ? -length : length, src_size[i]) << (rng() % 2 == 0 ? 14 : 16);
+					src_area.b[i].value_bits = internal::min(src_area.b[i].value_bits, int32_t(bits));
+					if (src_area.b[i].value_bits == 0) { src_area.b[i] = fixed32_t(src_size[i]); }
+				}
+				if (blocks) { // Every destination element covers a block of whole source elements, such as in 2x3 shrinks.
+					const int32_t ratio  = internal::min(1 + int32_t(rng() % 4), src_size[i]);
+					const int32_t length = internal::min(dst_area.b[i] > dst_area.a[i] ? dst_area.b[i] - dst_area.a[i] : dst_area.a[i] - dst_area.b[i], src_size[i] / ratio);
+					const int32_t offset = int32_t(rng() % uint32_t(src_size[i] - length * ratio + 1));
+					dst_area.b[i] = dst_area.b[i] > dst_area.a[i] ? dst_area.a[i] + length : dst_area.a[i] - length;
+					src_area.a[i] = fixed32_t(offset);
+					src_area.b[i] = fixed32_t(offset + length * ratio);
+				}
+			}
+			allocate();
+		}
+
+		/// @brief Creates a large case used for timing, upscaling by 1.6 and unmasked.
+		void timed( void )
+		{
+			const int32_t length = timed_extent<dimensions>();
+			for (uint32_t i = 0; i < dimensions; ++i) {
+				dst_size[i] = length;
+				src_size[i] = length * 5 / 8;
+				dst_area.a[i] = dst_mask.a[i] = 0;
+				dst_area.b[i] = dst_mask.b[i] = length;
+				src_area.a[i] = fixed32_t(0);
+				src_area.b[i] = fixed32_t(src_size[i]);
+			}
+			allocate();
+		}
+	};
+
+	/// @brief A static area with the same start and end on every axis.
+	/// @tparam dimensions The number of dimensions.
+	/// @tparam a The start along every axis.
+	/// @tparam b The end along every axis.
+	template < uint32_t dimensions, int32_t a, int32_t b > struct uniform_area;
+	template < int32_t a, int32_t b > struct uniform_area<1,a,b> { typedef StaticArea<a,b> type; };
+	template < int32_t a, int32_t b > struct uniform_area<2,a,b> { typedef StaticArea<a,a,b,b> type; };
+	template < int32_t a, int32_t b > struct uniform_area<3,a,b> { typedef StaticArea<a,a,a,b,b,b> type; };
+	template < int32_t a, int32_t b > struct uniform_area<4,a,b> { typedef StaticArea<a,a,a,a,b,b,b,b> type; };
+
+	/// @brief The areas of a static case, the same along every axis.
+	/// @tparam dst_a The start of the destination area.
+	/// @tparam dst_b The end of the destination area.
+	/// @tparam src_a The start of the source area, in whole source elements.
+	/// @tparam src_b The end of the source area, in whole source elements.
+	/// @tparam mask_a The start of the destination mask.
+	/// @tparam mask_b The end of the destination mask.
+	template < int32_t dst_a, int32_t dst_b, int32_t src_a, int32_t src_b, int32_t mask_a, int32_t mask_b >
+	struct static_areas
+	{
+		/// @brief Sets the areas of a case to the static areas.
+		template < typename type_t, uint32_t dimensions >
+		static void set(Case<type_t,dimensions> &c)
+		{
+			for (uint32_t i = 0; i < dimensions; ++i) {
+				c.dst_area.a[i] = dst_a;
+				c.dst_area.b[i] = dst_b;
+				c.src_area.a[i] = fixed32_t(src_a);
+				c.src_area.b[i] = fixed32_t(src_b);
+				c.dst_mask.a[i] = mask_a;
+				c.dst_mask.b[i] = mask_b;
+			}
+		}
+
+		/// @brief Scales the static areas.
+		template < uint32_t dimensions, typename processor_t >
+		static void run(const processor_t &processor)
+		{
+			scale<typename uniform_area<dimensions,dst_a,dst_b>::type, typename uniform_area<dimensions,src_a,src_b>::type, typename uniform_area<dimensions,mask_a,mask_b>::type>(processor);
+		}
+	};
+
+	typedef static_areas<0,8,0,4,0,8>   static_stretch; // An exact 2x stretch.
+	typedef static_areas<1,6,0,8,0,10>  static_shrink;  // A shrink by 1.6.
+	typedef static_areas<9,1,2,7,0,10>  static_mirror;  // A mirrored stretch.
+	typedef static_areas<-3,12,1,6,2,7> static_clip;    // A stretch clipped by the mask on both sides.
+
+	static constexpr int32_t STATIC_DST_SIZE = 10; // The number of destination elements along every axis of static cases.
+	static constexpr int32_t STATIC_SRC_SIZE = 8;  // The number of source elements along every axis of static cases.
+
+	/// @brief Determines if a path applies to an element type and number of dimensions.
+	template < typename type_t, uint32_t dimensions >
+	bool applies(path p)
+	{
+		switch (p) {
+		case path::separable: return dimensions == 2;
+		case path::pixels:    return internal::is_same<type_t,uint32_t>::value;
+		default:              return true;
+		}
+	}
+
+	/// @brief Adapts a random case to the requirements of a path, before the reference and the path scale copies of it.
+	/// @param rng The random number generator.
+	template < typename type_t, uint32_t dimensions >
+	void prepare(path p, Case<type_t,dimensions> &c, std::mt19937 &rng)
+	{
+		switch (p) {
+		case path::static_areas:
+			c.variant = rng() % 4;
+			for (uint32_t i = 0; i < dimensions; ++i) {
+				c.dst_size[i] = STATIC_DST_SIZE;
+				c.src_size[i] = STATIC_SRC_SIZE;
+			}
+			c.allocate();
+			switch (c.variant) {
+			case 0:  static_stretch::set(c); break;
+			case 1:  static_shrink::set(c);  break;
+			case 2:  static_mirror::set(c);  break;
+			default: static_clip::set(c);    break;
+			}
+			break;
+		case path::batch:
+		case path::binned: { // Pairs are shifted copies of the case with random source areas, overlapping each other in submission order.
+			const uint32_t count = 1 + rng() % 6;
+			c.dst_areas.assign(1, c.dst_area);
+			c.src_areas.assign(1, c.src_area);
+			for (uint32_t n = 1; n < count; ++n) {
+				Area<int32_t,dimensions>   dst_area = c.dst_area;
+				Area<fixed32_t,dimensions> src_area = c.src_area;
+				for (uint32_t i = 0; i < dimensions; ++i) {
+					const int32_t shift = int32_t(rng() % uint32_t(c.dst_size[i] + 1)) - c.dst_size[i] / 2;
+					dst_area.a[i] += shift;
+					dst_area.b[i] += shift;
+					if (rng() % 2 == 0) {
+						const uint32_t bits = uint32_t(c.src_size[i]) << 15;
+						src_area.a[i].value_bits = int32_t(rng() % (bits + 1));
+						src_area.b[i].value_bits = int32_t(rng() % (bits + 1));
+					}
+				}
+				c.dst_areas.push_back(dst_area);
+				c.src_areas.push_back(src_area);
+			}
+			c.tile_size = 1 + int32_t(rng() % 8);
+			for (uint32_t i = 0; i < dimensions; ++i) { // Large cases are not split into more tiles than elements.
+				c.tile_size = internal::max(c.tile_size, (c.dst_mask.b[i] > c.dst_mask.a[i] ? c.dst_mask.b[i] - c.dst_mask.a[i] : c.dst_mask.a[i] - c.dst_mask.b[i]) / 8);
+			}
+			break;
+		}
+		case path::in_place: // The destination is the source array with the same strides, and no axis is mirrored.
+			for (uint32_t i = 0; i < dimensions; ++i) {
+				if (c.dst_area.a[i] > c.dst_area.b[i]) { internal::swap(c.dst_area.a[i], c.dst_area.b[i]); }
+				if (c.src_area.a[i] > c.src_area.b[i]) { internal::swap(c.src_area.a[i], c.src_area.b[i]); }
+				if (c.dst_mask.a[i] > c.dst_mask.b[i]) { internal::swap(c.dst_mask.a[i], c.dst_mask.b[i]); }
+				c.dst_size[i] = c.src_size[i] + 1;
+				c.dst_stride[i] = c.src_stride[i];
+				c.dst_mask.a[i] = internal::min(c.dst_mask.a[i], c.dst_size[i]);
+				c.dst_mask.b[i] = internal::min(c.dst_mask.b[i], c.dst_size[i]);
+			}
+			c.dst = c.src;
+			break;
+		case path::subsampled:
+			for (uint32_t i = 0; i < dimensions; ++i) {
+				c.factor[i] = 1 + int32_t(rng() % 3);
+			}
+			break;
+		default:
+			break;
+		}
+	}
+
+	/// @brief Scales a case with scale_separable, or with its reference. Does nothing outside of 2D.
+	template < typename type_t, uint32_t dimensions >
+	void run_separable(bool, Case<type_t,dimensions>&) {}
+
+	/// @brief Scales a 2D case with scale_separable, or with its reference.
+	/// @param reference Determines if the reference is used.
+	template < typename type_t >
+	void run_separable(bool reference, Case<type_t,2> &c)
+	{
+		if (reference) {
+			scale(c.dst_area, c.src_area, separable_reference<linear_filter,type_t>(c.dst.data(), c.dst_stride, c.src.data(), c.src_stride, c.src_size, ScalePlan<2>(c.dst_area, c.src_area, c.dst_mask).src_delta), c.dst_mask);
+			return;
+		}
+		const int32_t width = c.dst_area.b[0] > c.dst_area.a[0] ? c.dst_area.b[0] - c.dst_area.a[0] : c.dst_area.a[0] - c.dst_area.b[0];
+		const int32_t rows  = separable<linear_filter,type_t,type_t>::rows(c.dst_area, c.src_area);
+		std::vector<float> ring(size_t(width) * size_t(rows));
+		scale_separable(c.dst_area, c.src_area, separable<linear_filter,type_t,type_t>(c.dst.data(), c.dst_stride, c.src.data(), c.src_stride, c.src_size, ring.data(), width, rows), c.dst_mask);
+	}
+
+	/// @brief Scales a case with write_pixels, or with its reference. Does nothing for element types other than uint32.
+	template < typename type_t, uint32_t dimensions >
+	void run_pixels(bool, Case<type_t,dimensions>&) {}
+
+	/// @brief Scales a uint32 case with write_pixels, or with its reference, reading the source as rgba8 and writing the destination as bgra8.
+	/// @param reference Determines if the reference is used.
+	template < uint32_t dimensions >
+	void run_pixels(bool reference, Case<uint32_t,dimensions> &c)
+	{
+		if (reference) {
+			scale(c.dst_area, c.src_area, pixel_reference<dimensions>(c.dst.data(), c.dst_stride, c.src.data(), c.src_stride), c.dst_mask);
+		} else {
+			scale(c.dst_area, c.src_area, write_pixels<bgra8,rgba8,dimensions>(c.dst.data(), c.dst_stride, c.src.data(), c.src_stride), c.dst_mask);
+		}
+	}
+
+	/// @brief Scales a case using a reference.
+	template < typename type_t, uint32_t dimensions >
+	void run_reference(sampling r, Case<type_t,dimensions> &c)
+	{
+		const reference<type_t,dimensions> nearest(c.dst.data(), c.dst_stride, c.src.data(), c.src_stride);
+		switch (r) {
+		case sampling::nearest:
+			if (c.dst_areas.empty()) {
+				scale(c.dst_area, c.src_area, nearest, c.dst_mask);
+			}
+			for (size_t i = 0; i < c.dst_areas.size(); ++i) {
+				scale(c.dst_areas[i], c.src_areas[i], nearest, c.dst_mask);
+			}
+			break;
+		case sampling::box:
+			scale(c.dst_area, c.src_area, box_reference<type_t,dimensions>(c.dst.data(), c.dst_stride, c.src.data(), c.src_stride, c.src_size, ScalePlan<dimensions>(c.dst_area, c.src_area, c.dst_mask).src_delta), c.dst_mask);
+			break;
+		case sampling::exact:
+			scale_exact(c.dst_area, c.src_area, nearest, c.dst_mask);
+			break;
+		case sampling::linear:
+			scale(c.dst_area, c.src_area, linear_reference<type_t,dimensions>(c.dst.data(), c.dst_stride, c.src.data(), c.src_stride, c.src_size, ScalePlan<dimensions>(c.dst_area, c.src_area, c.dst_mask).src_delta), c.dst_mask);
+			break;
+		case sampling::separable:
+			run_separable(true, c);
+			break;
+		case sampling::pixels:
+			run_pixels(true, c);
+			break;
+		case sampling::planes:
+			scale(c.dst_area, c.src_area, nearest, c.dst_mask);
+			scale(c.dst_area, c.src_area, write<type_t,type_t,dimensions>(c.dst.data(), c.dst_stride, c.src.data(), c.src_stride), c.dst_mask);
+			break;
+		case sampling::subsampled:
+			scale(c.dst_area, c.src_area, subsample(nearest, c.factor), c.dst_mask);
+			break;
+		}
+	}
+
+	/// @brief Scales a case using a path.
+	template < typename type_t, uint32_t dimensions >
+	void run_path(path p, Case<type_t,dimensions> &c, const thread_pool &pool)
+	{
+		const write<type_t,type_t,dimensions> writer(c.dst.data(), c.dst_stride, c.src.data(), c.src_stride);
+		switch (p) {
+		case path::rows:
+			scale(c.dst_area, c.src_area, writer, c.dst_mask);
+			break;
+		case path::streaming:
+			scale(c.dst_area, c.src_area, write<type_t,type_t,dimensions,streaming_stores>(c.dst.data(), c.dst_stride, c.src.data(), c.src_stride), c.dst_mask);
+			break;
+		case path::tables: {
+			ScalePlan<dimensions> plan(c.dst_area, c.src_area, c.dst_mask);
+			std::vector<int32_t> index(size_t(c.dst_size[0]));
+			tabulate(plan, writer, index.data(), nullptr, c.dst_size[0]);
+			execute(plan, writer);
+			break;
+		}
+		case path::tiled:
+			scale(c.dst_area, c.src_area, writer, c.dst_mask, tiled(16));
+			break;
+		case path::morton:
+			scale(c.dst_area, c.src_area, writer, c.dst_mask, tiled(8, true));
+			break;
+		case path::sparse: {
+			Occupancy<dimensions> occupancy;
+			occupancy.size = 4;
+			for (uint32_t i = 0; i < dimensions; ++i) {
+				occupancy.origin[i] = 0;
+				occupancy.cells[i] = (c.dst_size[i] + occupancy.size - 1) / occupancy.size;
+			}
+			std::vector<uint64_t> bits(size_t(occupancy.words()), ~uint64_t(0));
+			occupancy.bits = bits.data();
+			scale(c.dst_area, c.src_area, writer, c.dst_mask, sparse<dimensions>(occupancy));
+			break;
+		}
+		case path::streamed: {
+			const no_reader reader = no_reader();
+			scale(c.dst_area, c.src_area, writer, c.dst_mask, streamed<no_reader>(reader));
+			break;
+		}
+		case path::parallel:
+			scale_parallel(c.dst_area, c.src_area, writer, c.dst_mask, pool);
+			break;
+		case path::work_stealing:
+			scale_work_stealing(c.dst_area, c.src_area, writer, c.dst_mask, pool, 64);
+			break;
+		case path::async:
+			scale_async(c.dst_area, c.src_area, writer, c.dst_mask, pool, 8).wait();
+			break;
+		case path::box:
+			scale(c.dst_area, c.src_area, write_box<type_t,type_t,dimensions>(c.dst.data(), c.dst_stride, c.src.data(), c.src_stride, c.src_size), c.dst_mask);
+			break;
+		case path::exact:
+			scale_exact(c.dst_area, c.src_area, writer, c.dst_mask);
+			break;
+		case path::static_areas:
+			switch (c.variant) {
+			case 0:  static_stretch::run<dimensions>(writer); break;
+			case 1:  static_shrink::run<dimensions>(writer);  break;
+			case 2:  static_mirror::run<dimensions>(writer);  break;
+			default: static_clip::run<dimensions>(writer);    break;
+			}
+			break;
+		case path::batch: {
+			std::vector< ScalePlan<dimensions> > plans(c.dst_areas.size());
+			scale_batch(c.dst_areas.data(), c.src_areas.data(), uint32_t(c.dst_areas.size()), writer, c.dst_mask, plans.data());
+			break;
+		}
+		case path::binned: {
+			const size_t tiles = size_t(TileBins<dimensions>::tile_count(c.dst_mask, c.tile_size));
+			std::vector< ScalePlan<dimensions> > plans(c.dst_areas.size());
+			std::vector<uint32_t> offsets(tiles + 1), entries(tiles * c.dst_areas.size());
+			TileBins<dimensions> bins;
+			bin_batch(bins, c.dst_areas.data(), c.src_areas.data(), uint32_t(c.dst_areas.size()), c.dst_mask, c.tile_size, plans.data(), offsets.data(), uint32_t(offsets.size()), entries.data(), uint32_t(entries.size()));
+			scale_binned(bins, writer, pool);
+			break;
+		}
+		case path::in_place:
+			scale(c.dst_area, c.src_area, write<type_t,type_t,dimensions>(c.dst.data(), c.dst_stride, c.dst.data(), c.src_stride), c.dst_mask, in_place());
+			break;
+		case path::linear:
+			scale(c.dst_area, c.src_area, write_linear<type_t,type_t,dimensions>(c.dst.data(), c.dst_stride, c.src.data(), c.src_stride, c.src_size), c.dst_mask);
+			break;
+		case path::separable:
+			run_separable(false, c);
+			break;
+		case path::pixels:
+			run_pixels(false, c);
+			break;
+		case path::planes:
+			scale(c.dst_area, c.src_area, planes(reference<type_t,dimensions>(c.dst.data(), c.dst_stride, c.src.data(), c.src_stride), writer), c.dst_mask);
+			break;
+		case path::subsampled:
+			scale(c.dst_area, c.src_area, subsample(writer, c.factor), c.dst_mask);
+			break;
+		}
+	}
+
+	/// @brief Reports a failed check of a limit.
+	/// @param passed Determines if the check passed.
+	/// @param name The name of the check.
+	/// @return 1 if the check failed.
+	uint32_t check(bool passed, const char *name)
+	{
+		if (!passed) { std::fprintf(stderr, "limits: %s failed\n", name); }
+		return passed ? 0 : 1;
+	}
+
+	/// @brief Checks that bin_batch rejects masks divided into too many tiles and undersized arrays without writing past them or to the plans, and bins areas near the limits of the coordinate range.
+	/// @return The number of failed checks.
+	uint32_t check_bins( void )
+	{
+		uint32_t failed = 0;
+		const Area<int32_t,2>   quad     = { { 0, 0 }, { 4, 4 } };
+		const Area<fixed32_t,2> quad_src = { { fixed32_t(0), fixed32_t(0) }, { fixed32_t(2), fixed32_t(2) } };
+		ScalePlan<2> plans[2];
+		uint32_t     offsets[5];
+		uint32_t     entries[4];
+		TileBins<2>  bins;
+		plans[0].dst_area.a[0] = -1; // Marks the plan as unwritten.
+
+		const Area<int32_t,2> huge = { { 0, 0 }, { 65536, 65536 } }; // 2^32 tiles of one element.
+		failed += check(TileBins<2>::tile_count(huge, 1) > TileBins<2>::MAX_TILES, "tile_count saturates");
+		failed += check(!bin_batch(bins, &quad, &quad_src, 1, huge, 1, plans, offsets, 2, entries, 4) && bins.count == 0 && plans[0].dst_area.a[0] == -1, "too many tiles");
+
+		const Area<int32_t,2> small = { { 0, 0 }, { 4, 4 } };
+		failed += check(!bin_batch(bins, &quad, &quad_src, 1, small, 2, plans, offsets, 4, entries, 4) && bins.count == 0 && plans[0].dst_area.a[0] == -1, "too few offsets");
+		failed += check(!bin_batch(bins, &quad, &quad_src, 1, small, 2, plans, offsets, 5, entries, 3) && bins.count == 0 && plans[0].dst_area.a[0] == -1, "too few entries");
+		failed += check(bin_batch(bins, &quad, &quad_src, 1, small, 2, plans, offsets, 5, entries, 4) && bins.count == 4 && offsets[4] == 4, "exact capacity");
+
+		// A mask spanning almost the entire coordinate range, so that offsets from its start do not fit in int32_t.
+		const Area<int32_t,1>   wide     = { { -2147483647 }, { 2147483647 } };
+		const Area<int32_t,1>   far      = { { 2147483000 }, { 2147483100 } };
+		const Area<fixed32_t,1> far_src  = { { fixed32_t(0) }, { fixed32_t(4) } };
+		const int32_t           size     = 1 << 30;
+		ScalePlan<1> far_plan;
+		uint32_t     far_offsets[5];
+		uint32_t     far_entry = 0;
+		TileBins<1>  far_bins;
+		const bool binned = bin_batch(far_bins, &far, &far_src, 1, wide, size, &far_plan, far_offsets, 5, &far_entry, 1);
+		failed += check(binned && far_bins.count == 4 && far_offsets[3] == 0 && far_offsets[4] == 1, "wide mask");
+		failed += check(binned && far_bins.tile(3).a[0] <= far.a[0] && far_bins.tile(3).b[0] == wide.b[0], "wide mask tile");
+		return failed;
+	}
+
+	/// @brief A processor that records the source index of every destination element along one axis.
+	/// @tparam fixed_t The fixed-point type of the source index.
+	template < typename fixed_t >
+	class record
+	{
+	private:
+		std::vector<fixed_t> &m_src;   // Receives the source index of each element.
+		int32_t               m_start; // The destination index of the first element.
+
+	public:
+		/// @brief Creates a new record object.
+		/// @param src Receives the source index of each element.
+		/// @param start The destination index of the first element.
+		record(std::vector<fixed_t> &src, int32_t start) : m_src(src), m_start(start) {}
+
+		/// @brief Records an element.
+		/// @param dst The destination index.
+		/// @param src The source index.
+		void operator()(const Point<int32_t,1> &dst, const Point<fixed_t,1> &src) const
+		{
+			m_src[size_t(dst[0] - m_start)] = src[0];
+		}
+	};
+
+	/// @brief Checks plans and traversals of fixed-point formats other than fixed32_t: source areas of fixed<64,32> reaching almost to ±2^31, whose differences do not fit in 64 bits, and runs of fixed<16,8> through write, which go through the kernels of fixed32_t.
+	/// @return The number of failed checks.
+	uint32_t check_formats( void )
+	{
+		typedef fixed<64,32> fixed64_t;
+		typedef fixed<16,8>  fixed16_t;
+		uint32_t failed = 0;
+#if defined(__SIZEOF_INT128__)
+		const int64_t limit = (int64_t(1) << 31) - 1;
+		const struct { int64_t a, b; bool flip; } areas[] = {
+			{ -limit, limit, false }, { limit, -limit, false }, { -limit, limit, true }, { -limit, limit - 7, false }, { 5 - limit, limit, true }
+		};
+		const Area<int32_t,1> mask = { { 100 }, { 900 } };
+		for (const auto &area : areas) {
+			const Area<int32_t,1>   dst = { { area.flip ? 1000 : 0 }, { area.flip ? 0 : 1000 } };
+			Area<fixed64_t,1> src;
+			src.a[0].value_bits = area.a * (int64_t(1) << 32); // Multiplied, since converting shifts negative numbers.
+			src.b[0].value_bits = area.b * (int64_t(1) << 32);
+			const __int128 diff = __int128(src.b[0].value_bits) - src.a[0].value_bits;
+			const __int128 lo   = src.a[0].value_bits < src.b[0].value_bits ? src.a[0].value_bits : src.b[0].value_bits;
+			const __int128 hi   = src.a[0].value_bits < src.b[0].value_bits ? src.b[0].value_bits : src.a[0].value_bits;
+			const __int128 sign = area.flip ? -1 : 1; // The difference in the order the destination is stepped through.
+			const __int128 delta = sign * diff / 1000;
+			const ScalePlan<1,fixed64_t> plan(dst, src, mask);
+			ScalePlan<1,fixed64_t> batch;
+			const bool batched = plan_batch(&dst, &src, 1, mask, &batch) == 1;
+			failed += check(!plan.empty && __int128(plan.src_delta[0].value_bits) == delta, "fixed<64,32> delta");
+			failed += check(batched && batch.src_delta[0].value_bits == plan.src_delta[0].value_bits && batch.src_start[0].value_bits == plan.src_start[0].value_bits, "fixed<64,32> batch");
+
+			std::vector<fixed64_t> stepped(800), exact(800);
+			scale(dst, src, record<fixed64_t>(stepped, mask.a[0]), mask);
+			scale_exact(dst, src, record<fixed64_t>(exact, mask.a[0]), mask);
+			bool inside = true, drifted = false;
+			for (int32_t k = 0; k < 800; ++k) {
+				const __int128 start = delta >= 0 ? lo : hi + delta;
+				inside  = inside && __int128(stepped[size_t(k)].value_bits) == start + delta * (k + mask.a[0]) && stepped[size_t(k)].value_bits >= lo && stepped[size_t(k)].value_bits < hi;
+				// Element k of the destination starts at floor((k + o) * diff / length) from the lower end of the source area, where o is 1 when stepping through the source area backwards.
+				const __int128 n     = sign * diff < 0 ? mask.a[0] + k + 1 : mask.a[0] + k;
+				const __int128 scaled = sign * diff * n;
+				const __int128 offset = scaled >= 0 ? scaled / 1000 : -((-scaled + 999) / 1000);
+				drifted = drifted || __int128(exact[size_t(k)].value_bits) != (sign * diff >= 0 ? lo : hi) + offset;
+			}
+			failed += check(inside, "fixed<64,32> scale");
+			failed += check(!drifted, "fixed<64,32> scale_exact");
+		}
+#endif
+		// A tile of fixed<16,8> copied through write, against sampling every element on its own.
+		std::vector<uint8_t> tile(64 * 64), expected(48 * 40, 0), actual(48 * 40, 0);
+		for (size_t i = 0; i < tile.size(); ++i) { tile[i] = uint8_t(i * 2654435761u >> 13); }
+		const Point<int32_t,2>  tile_stride = { 1, 64 };
+		const Point<int32_t,2>  out_stride  = { 1, 48 };
+		const Area<int32_t,2>   out_area    = { { 47, 1 }, { 1, 39 } };
+		const Area<int32_t,2>   out_mask    = { { 0, 0 }, { 48, 40 } };
+		const Area<fixed16_t,2> tile_area   = { { fixed16_t(3), fixed16_t(60) }, { fixed16_t(61), fixed16_t(2) } };
+		scale(out_area, tile_area, write<uint8_t,uint8_t,2>(actual.data(), out_stride, tile.data(), tile_stride), out_mask);
+		const ScalePlan<2,fixed16_t> plan(out_area, tile_area, out_mask);
+		for (int32_t y = plan.dst_area.a[1]; y < plan.dst_area.b[1]; ++y) {
+			for (int32_t x = plan.dst_area.a[0]; x < plan.dst_area.b[0]; ++x) {
+				fixed16_t u = plan.src_start[0], v = plan.src_start[1];
+				u.value_bits = int16_t(u.value_bits + plan.src_delta[0].value_bits * (x - plan.dst_area.a[0]));
+				v.value_bits = int16_t(v.value_bits + plan.src_delta[1].value_bits * (y - plan.dst_area.a[1]));
+				expected[size_t(y * 48 + x)] = tile[size_t(int32_t(v) * 64 + int32_t(u))];
+			}
+		}
+		failed += check(expected == actual, "fixed<16,8> write");
+		return failed;
+	}
+
+	/// @brief Checks that handles of scale_async read as completed calls with no tiles once moved from, and that assigning to a handle waits for its call to complete first.
+	/// @return The number of failed checks.
+	uint32_t check_handles( void )
+	{
+		uint32_t failed = 0;
+		const thread_pool pool(1);
+		Case<uint32_t,2> c;
+		for (uint32_t i = 0; i < 2; ++i) {
+			c.dst_size[i] = c.dst_area.b[i] = c.dst_mask.b[i] = 64;
+			c.src_size[i] = 40;
+			c.dst_area.a[i] = c.dst_mask.a[i] = 0;
+			c.src_area.a[i] = fixed32_t(0);
+			c.src_area.b[i] = fixed32_t(40);
+		}
+		c.allocate();
+		std::vector<uint32_t> other(c.dst.size(), 0x5a5a5a5au);
+		const uneven slow(c.dst.data(), c.dst_stride, c.src.data(), c.src_stride, c.dst_size[1]);
+		const uneven fast(other.data(), c.dst_stride, c.src.data(), c.src_stride, 0);
+
+		scale_handle<2> handle = scale_async(c.dst_area, c.src_area, slow, c.dst_mask, pool, 4);
+		scale_handle<2> moved(std::move(handle));
+		const Area<int32_t,2> tile = handle.tile(0);
+		failed += check(handle.tiles() == 0 && handle.ready() && handle.ready(0) && tile.a[0] == tile.b[0], "moved-from handle");
+		handle.wait();
+		handle.wait(0);
+		moved = scale_async(c.dst_area, c.src_area, fast, c.dst_mask, pool, 4);
+		failed += check(uint32_t(std::count(c.dst.begin(), c.dst.end(), 0x5a5a5a5au)) == 0, "move assignment waits");
+		moved.wait();
+		failed += check(moved.tiles() == 4 && moved.ready() && other == c.dst, "move assignment takes over");
+		return failed;
+	}
+
+	/// @brief Repeatedly runs a function until a minimum amount of time has passed.
+	/// @return The number of seconds per run.
+	template < typename function_t >
+	double measure(const function_t &function, double min_seconds)
+	{
+		typedef std::chrono::steady_clock clock;
+		function(); // Warm up caches and page in memory.
+		uint64_t runs = 0;
+		const clock::time_point start = clock::now();
+		double elapsed = 0.0;
+		do {
+			function();
+			++runs;
+			elapsed = std::chrono::duration<double>(clock::now() - start).count();
+		} while (elapsed < min_seconds);
+		return elapsed / double(runs);
+	}
+
+	/// @brief Checks and times all paths for a given element type and number of dimensions.
+	/// @return The number of mismatching cases.
+	template < typename type_t, uint32_t dimensions >
+	uint32_t run(uint32_t cases, double min_seconds, uint32_t seed, const thread_pool &pool)
+	{
+		uint32_t total = 0;
+		for (const auto &p : PATHS) {
+			if (!applies<type_t,dimensions>(p.id)) { continue; }
+			std::mt19937 rng(seed);
+			uint32_t mismatches = 0;
+			for (uint32_t n = 0; n < cases; ++n) {
+				Case<type_t,dimensions> expected;
+				expected.randomize(rng);
+				prepare(p.id, expected, rng);
+				Case<type_t,dimensions> actual = expected;
+				run_reference(p.reference, expected);
+				run_path(p.id, actual, pool);
+				if (expected.dst != actual.dst) {
+					if (mismatches == 0) {
+						std::fprintf(stderr, "%s,%u,%s: mismatch in case %u\n", p.name, dimensions, type_name<type_t>(), n);
+					}
+					++mismatches;
+				}
+			}
+			Case<type_t,dimensions> timed;
+			timed.timed();
+			prepare(p.id, timed, rng);
+			const double reference_seconds = measure([&]() { run_reference(p.reference, timed); }, min_seconds);
+			const double path_seconds      = measure([&]() { run_path(p.id, timed, pool); }, min_seconds);
+			std::printf("%s,%u,%s,%u,%u,%.9f,%.9f,%.2f\n", p.name, dimensions, type_name<type_t>(), cases, mismatches, reference_seconds, path_seconds, reference_seconds / path_seconds);
+			total += mismatches;
+		}
+		return total;
+	}
+
+	/// @brief Times scale_work_stealing against scale_parallel on four threads with a processor whose rows in the first eighth of the destination block, so that the first slab of scale_parallel holds all slow rows. Prints one CSV row with scale_parallel as the reference.
+	/// @return The number of mismatching cases.
+	uint32_t run_uneven(double min_seconds)
+	{
+		const thread_pool pool(3);
+		Case<uint32_t,2> c;
+		for (uint32_t i = 0; i < 2; ++i) {
+			c.dst_size[i] = c.dst_area.b[i] = c.dst_mask.b[i] = 256;
+			c.src_size[i] = 160;
+			c.dst_area.a[i] = c.dst_mask.a[i] = 0;
+			c.src_area.a[i] = fixed32_t(0);
+			c.src_area.b[i] = fixed32_t(160);
+		}
+		c.allocate();
+		const uneven processor(c.dst.data(), c.dst_stride, c.src.data(), c.src_stride, c.dst_size[1] / 8);
+		scale_parallel(c.dst_area, c.src_area, processor, c.dst_mask, pool);
+		const std::vector<uint32_t> expected = c.dst;
+		c.dst.assign(c.dst.size(), 0x5a5a5a5au);
+		scale_work_stealing(c.dst_area, c.src_area, processor, c.dst_mask, pool, uint64_t(c.dst_size[0]));
+		const uint32_t mismatches = c.dst == expected ? 0 : 1;
+		if (mismatches > 0) { std::fprintf(stderr, "work_stealing_uneven: mismatch\n"); }
+		const double parallel_seconds = measure([&]() { scale_parallel(c.dst_area, c.src_area, processor, c.dst_mask, pool); }, min_seconds);
+		const double stealing_seconds = measure([&]() { scale_work_stealing(c.dst_area, c.src_area, processor, c.dst_mask, pool, uint64_t(c.dst_size[0])); }, min_seconds);
+		std::printf("work_stealing_uneven,2,uint32,1,%u,%.9f,%.9f,%.2f\n", mismatches, parallel_seconds, stealing_seconds, parallel_seconds / stealing_seconds);
+		return mismatches;
+	}
+
+#ifdef ORACLE_OPENCL
+	/// @brief The first OpenCL device found, with a context and a queue, or none if there are no devices.
+	struct opencl_device
+	{
+		cl_device_id     device;  // The device, or null.
+		cl_context       context; // The context of the device, or null.
+		cl_command_queue queue;   // The in-order queue of the device, or null if there is no device.
+
+		/// @brief Finds a device.
+		opencl_device( void ) : device(nullptr), context(nullptr), queue(nullptr)
+		{
+			cl_platform_id platforms[8];
+			cl_uint count = 0;
+			if (clGetPlatformIDs(8, platforms, &count) != CL_SUCCESS) { return; }
+			for (cl_uint i = 0; i < count && i < 8 && device == nullptr; ++i) {
+				if (clGetDeviceIDs(platforms[i], CL_DEVICE_TYPE_ALL, 1, &device, nullptr) != CL_SUCCESS) { device = nullptr; }
+			}
+			if (device == nullptr) { return; }
+			cl_int status = CL_SUCCESS;
+			context = clCreateContext(nullptr, 1, &device, nullptr, nullptr, &status);
+			if (status != CL_SUCCESS) { context = nullptr; return; }
+			queue = clCreateCommandQueue(context, device, 0, &status);
+			if (status != CL_SUCCESS) { queue = nullptr; }
+		}
+
+		opencl_device(const opencl_device&) = delete;
+		opencl_device &operator=(const opencl_device&) = delete;
+
+		/// @brief Releases the queue and the context.
+		~opencl_device( void )
+		{
+			if (queue != nullptr) { clReleaseCommandQueue(queue); }
+			if (context != nullptr) { clReleaseContext(context); }
+		}
+	};
+
+	/// @brief Scales a case on a device, copying both arrays to device buffers and the destination back once the write has completed.
+	/// @param device The device.
+	/// @param scaler The scaler, built for the device.
+	/// @param linear Determines if write_linear is used instead of write.
+	/// @return CL_SUCCESS, or the error produced by OpenCL.
+	template < typename type_t, uint32_t dimensions >
+	cl_int run_device(const opencl_device &device, opencl_scaler<type_t,type_t,dimensions> &scaler, bool linear, Case<type_t,dimensions> &c)
+	{
+		cl_int status = CL_SUCCESS;
+		cl_mem src = clCreateBuffer(device.context, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR, c.src.size() * sizeof(type_t), c.src.data(), &status);
+		if (status != CL_SUCCESS) { return status; }
+		cl_mem dst = clCreateBuffer(device.context, CL_MEM_READ_WRITE | CL_MEM_COPY_HOST_PTR, c.dst.size() * sizeof(type_t), c.dst.data(), &status);
+		if (status == CL_SUCCESS) {
+			const ScalePlan<dimensions> plan(c.dst_area, c.src_area, c.dst_mask);
+			status = linear ? scaler.write_linear(plan, dst, c.dst_stride, src, c.src_stride, c.src_size) : scaler.write(plan, dst, c.dst_stride, src, c.src_stride);
+			if (status == CL_SUCCESS) { status = clEnqueueReadBuffer(device.queue, dst, CL_TRUE, 0, c.dst.size() * sizeof(type_t), c.dst.data(), 0, nullptr, nullptr); }
+			clReleaseMemObject(dst);
+		}
+		clReleaseMemObject(src);
+		return status;
+	}
+
+	/// @brief Compares destinations written by write_linear on the host and on a device, allowing for differences in floating-point rounding. Interpolating between large source elements can lose bits of the difference, so the tolerance depends on the range of the type rather than on the elements.
+	/// @return True if every element is within one plus one part in 2^20 of the range of the type.
+	template < typename type_t >
+	bool rounded_equal(const std::vector<type_t> &expected, const std::vector<type_t> &actual)
+	{
+		const double tolerance = 1.0 + double(std::numeric_limits<type_t>::max()) * (1.0 / 1048576.0);
+		for (size_t i = 0; i < expected.size(); ++i) {
+			if (std::fabs(double(expected[i]) - double(actual[i])) > tolerance) { return false; }
+		}
+		return true;
+	}
+
+	/// @brief Checks and times opencl_scaler against write and write_linear on the host for a given element type and number of dimensions. Prints one CSV row per kernel with the host as the reference, timing the device including the copies to and from the device.
+	/// @return The number of mismatching cases.
+	template < typename type_t, uint32_t dimensions >
+	uint32_t run_opencl(const opencl_device &device, uint32_t cases, double min_seconds, uint32_t seed, const thread_pool &pool)
+	{
+		opencl_scaler<type_t,type_t,dimensions> scaler(device.context, device.device, device.queue);
+		if (scaler.status() != CL_SUCCESS) {
+			std::fprintf(stderr, "opencl,%u,%s: build failed with %d\n", dimensions, type_name<type_t>(), int(scaler.status()));
+			return 1;
+		}
+		uint32_t total = 0;
+		for (uint32_t k = 0; k < 2; ++k) {
+			const bool  linear = k == 1;
+			const path  p      = linear ? path::linear : path::rows;
+			const char *name   = linear ? "opencl_linear" : "opencl";
+			std::mt19937 rng(seed);
+			uint32_t mismatches = 0;
+			for (uint32_t n = 0; n < cases; ++n) {
+				Case<type_t,dimensions> expected;
+				expected.randomize(rng);
+				Case<type_t,dimensions> actual = expected;
+				run_path(p, expected, pool);
+				const cl_int status = run_device(device, scaler, linear, actual);
+				if (status != CL_SUCCESS || !(linear ? rounded_equal(expected.dst, actual.dst) : expected.dst == actual.dst)) {
+					if (mismatches == 0) {
+						std::fprintf(stderr, "%s,%u,%s: mismatch in case %u (status %d)\n", name, dimensions, type_name<type_t>(), n, int(status));
+					}
+					++mismatches;
+				}
+			}
+			Case<type_t,dimensions> timed;
+			timed.timed();
+			const double host_seconds   = measure([&]() { run_path(p, timed, pool); }, min_seconds);
+			const double device_seconds = measure([&]() { run_device(device, scaler, linear, timed); }, min_seconds);
+			std::printf("%s,%u,%s,%u,%u,%.9f,%.9f,%.2f\n", name, dimensions, type_name<type_t>(), cases, mismatches, host_seconds, device_seconds, host_seconds / device_seconds);
+			total += mismatches;
+		}
+		return total;
+	}
+
+	/// @brief Checks and times opencl_scaler for all element types on the first OpenCL device in 1D to 3D. Reports on stderr and checks nothing if there is no device.
+	/// @return The number of mismatching cases.
+	uint32_t run_opencl_all(uint32_t cases, double min_seconds, uint32_t seed, const thread_pool &pool)
+	{
+		const opencl_device device;
+		if (device.queue == nullptr) {
+			std::fprintf(stderr, "opencl: no device, skipped\n");
+			return 0;
+		}
+		uint32_t total = 0;
+		total += run_opencl<uint8_t,1>(device, cases, min_seconds, seed, pool) + run_opencl<uint8_t,2>(device, cases, min_seconds, seed, pool) + run_opencl<uint8_t,3>(device, cases, min_seconds, seed, pool);
+		total += run_opencl<uint16_t,1>(device, cases, min_seconds, seed, pool) + run_opencl<uint16_t,2>(device, cases, min_seconds, seed, pool) + run_opencl<uint16_t,3>(device, cases, min_seconds, seed, pool);
+		total += run_opencl<uint32_t,1>(device, cases, min_seconds, seed, pool) + run_opencl<uint32_t,2>(device, cases, min_seconds, seed, pool) + run_opencl<uint32_t,3>(device, cases, min_seconds, seed, pool);
+		return total;
+	}
+#endif
+
+	/// @brief Checks and times all paths for a given element type.
+	/// @return The number of mismatching cases.
+	template < typename type_t >
+	uint32_t run_all(uint32_t cases, double min_seconds, uint32_t seed, const thread_pool &pool)
+	{
+		return run<type_t,1>(cases, min_seconds, seed, pool) + run<type_t,2>(cases, min_seconds, seed, pool) + run<type_t,3>(cases, min_seconds, seed, pool) + run<type_t,4>(cases, min_seconds, seed, pool);
+	}
+}
+
+int main(int argc, char **argv)
+{
+	const uint32_t cases       = argc > 1 ? uint32_t(std::atoi(argv[1])) : 1000;
+	const double   min_seconds = argc > 2 ? std::atof(argv[2]) : 0.05;
+	const uint32_t seed        = argc > 3 ? uint32_t(std::atoi(argv[3])) : 1;
+	const thread_pool pool;
+	std::printf("path,dimensions,type,cases,mismatches,reference_seconds,path_seconds,speedup\n");
+	uint32_t mismatches = check_bins() + check_formats() + check_handles();
+	mismatches += run_all<uint8_t>(cases, min_seconds, seed, pool);
+	mismatches += run_all<uint16_t>(cases, min_seconds, seed, pool);
+	mismatches += run_all<uint32_t>(cases, min_seconds, seed, pool);
+#ifdef ORACLE_OPENCL
+	mismatches += run_opencl_all(cases, min_seconds, seed, pool);
+#endif
+	mismatches += run_uneven(min_seconds);
+	return mismatches > 0 ? 1 : 0;
+}
@@ -10,6 +10,27 @@
 
 #include <cstdint>
 
+// Select the SIMD instruction set used by the built-in processors. Define CC0_SCALE_NO_SIMD to only use scalar code.
+#if !defined(CC0_SCALE_NO_SIMD)
+	#if defined(__AVX2__)
+		#include <immintrin.h>
+		#define CC0_SCALE_AVX2
+		#define CC0_SCALE_SSE2
+	#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+		#include <emmintrin.h>
+		#define CC0_SCALE_SSE2
+	#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+		#include <arm_neon.h>
+		#define CC0_SCALE_NEON
+	#endif
+#endif
+
+// Select the intrinsic used to find the lowest set bit of a word.
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+	#include <intrin.h>
+	#pragma intrinsic(_BitScanForward64)
+#endif
+
 namespace cc0
 {
 	namespace scale
@@ -69,6 +90,10 @@ namespace cc0
 		template < uint32_t bits, uint32_t precision >
 		struct fixed
 		{
+			typedef typename internal::intinfo<bits>::int_t       int_t;  // The integer type of the binary representation.
+			typedef typename internal::intinfo<bits>::uint_t      uint_t; // The unsigned integer type of the binary representation, used for arithmetic that wraps instead of overflowing.
+			typedef typename internal::intinfo<bits>::next::int_t next_t; // The next, larger integer type used for intermediate results that could otherwise overflow. The same as int_t for 64-bit types.
+
 			typename internal::intinfo<bits>::int_t value_bits; // The binary representation of the fixed-point number.
 
 			/// @brief The default constructor. Does nothing, and does not initialize the instance.
@@ -162,6 +187,14 @@ namespace cc0
 			Point<type_t,dimensions> b; // The end-point.
 		};
 
+		/// @brief A value processors can return to control the traversal. Processors returning void always proceed.
+		enum class control : uint8_t
+		{
+			proceed,  // Continue with the next element or row.
+			skip_row, // Skip the rest of the current run along the innermost axis. Has the same effect as proceed when returned from a row processor.
+			stop      // Stop the traversal.
+		};
+
 		/// @brief For internal use only. Do not use.
 		namespace internal
 		{
@@ -199,11 +232,165 @@ namespace cc0
 				return a > b ? a : b;
 			}
 
+			/// @brief Divides two integers, rounding towards negative infinity.
+			/// @tparam type_t The type of the values.
+			/// @param a The dividend.
+			/// @param b The divisor. Must be positive.
+			/// @return The quotient.
+			template < typename type_t >
+			inline type_t floor_div(type_t a, type_t b)
+			{
+				const type_t q = a / b;
+				return (a % b != 0 && a < 0) ? q - 1 : q;
+			}
+
+			/// @brief Returns the distance between two fixed-point numbers in bits. Exact for every format up to 64 bits, where the signed difference would overflow.
+			/// @tparam fixed_t The fixed-point type.
+			/// @param a The first number.
+			/// @param b The second number.
+			/// @return The magnitude of the difference between the binary representations.
+			template < typename fixed_t >
+			inline uint64_t span(fixed_t a, fixed_t b)
+			{
+				typedef typename fixed_t::uint_t uint_t;
+				return a.value_bits < b.value_bits ? uint64_t(uint_t(uint_t(b.value_bits) - uint_t(a.value_bits))) : uint64_t(uint_t(uint_t(a.value_bits) - uint_t(b.value_bits)));
+			}
+
+			/// @brief Creates a fixed-point number from the magnitude and sign of its binary representation, wrapping like the arithmetic of the type.
+			/// @tparam fixed_t The fixed-point type.
+			/// @param magnitude The magnitude of the binary representation.
+			/// @param negative Determines if the number is negative.
+			/// @return The number.
+			template < typename fixed_t >
+			inline fixed_t from_magnitude(uint64_t magnitude, bool negative)
+			{
+				fixed_t f;
+				f.value_bits = typename fixed_t::int_t(typename fixed_t::uint_t(negative ? 0 - magnitude : magnitude));
+				return f;
+			}
+
+			/// @brief Advances a source index by a number of source deltas. Computed in the unsigned type of the format, so the product wraps the way the index itself does rather than overflowing an intermediate type, which has no larger type to widen to for 64-bit formats.
+			/// @tparam fixed_t The fixed-point type.
+			/// @param index The source index.
+			/// @param delta The source delta.
+			/// @param count The number of deltas to advance by. Can be negative.
+			/// @return The advanced source index.
+			template < typename fixed_t >
+			inline fixed_t advance(fixed_t index, fixed_t delta, int64_t count)
+			{
+				typedef typename fixed_t::uint_t uint_t;
+				index.value_bits = typename fixed_t::int_t(uint_t(uint64_t(uint_t(index.value_bits)) + uint64_t(int64_t(delta.value_bits)) * uint64_t(count)));
+				return index;
+			}
+
+			/// @brief Returns the index of the lowest set bit of a word.
+			/// @param x The word. Must not be zero.
+			/// @return The number of trailing zero bits.
+			inline uint32_t lowest_bit(uint64_t x)
+			{
+#if defined(__GNUC__) || defined(__clang__)
+				return uint32_t(__builtin_ctzll(x));
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+				unsigned long i;
+				_BitScanForward64(&i, x);
+				return uint32_t(i);
+#else
+				uint32_t i = 0;
+				if ((x & 0xFFFFFFFFu) == 0) { x >>= 32; i += 32; }
+				if ((x & 0xFFFFu) == 0)     { x >>= 16; i += 16; }
+				if ((x & 0xFFu) == 0)       { x >>= 8;  i += 8; }
+				if ((x & 0xFu) == 0)        { x >>= 4;  i += 4; }
+				if ((x & 0x3u) == 0)        { x >>= 2;  i += 2; }
+				return i + uint32_t((x & 1) == 0);
+#endif
+			}
+
+			/// @brief Produces a value of the given type in unevaluated contexts. Never defined, and must never be called.
+			/// @tparam type_t The type of the value.
+			/// @return A reference to a value of the given type.
+			template < typename type_t >
+			type_t &&declval( void );
+
+			/// @brief Determines at compile-time if a processor accepts an entire run of the innermost axis at once, i.e. if it can be called as `processor(dst_row_start, src_row_start, src_delta, count)`.
+			/// @tparam processor_t The type of the processor function/functor.
+			/// @tparam dimensions The number of dimensions to iterate over.
+			/// @tparam fixed_t The fixed-point type of the source index.
+			template < typename processor_t, uint32_t dimensions, typename fixed_t = fixed32_t >
+			class is_row_processor
+			{
+			private:
+				template < typename type_t > static int16_t test(decltype(void(declval<const type_t&>()(declval<const Point<int32_t,dimensions>&>(), declval<const Point<fixed_t,dimensions>&>(), declval<const Point<fixed_t,dimensions>&>(), int32_t(0))))*);
+				template < typename type_t > static int8_t  test(...);
+
+			public:
+				static constexpr bool value = sizeof(test<processor_t>(nullptr)) == sizeof(int16_t); // True if the processor accepts entire rows.
+			};
+
+			/// @brief Determines at compile-time if a processor accepts an entire run of the innermost axis fed from precomputed source index tables, i.e. if it can be called as `processor(dst_row_start, src_row_start, src_delta, index_table, weight_table, count)`.
+			/// @tparam processor_t The type of the processor function/functor.
+			/// @tparam dimensions The number of dimensions to iterate over.
+			/// @tparam fixed_t The fixed-point type of the source index.
+			template < typename processor_t, uint32_t dimensions, typename fixed_t = fixed32_t >
+			class is_table_processor
+			{
+			private:
+				template < typename type_t > static int16_t test(decltype(void(declval<const type_t&>()(declval<const Point<int32_t,dimensions>&>(), declval<const Point<fixed_t,dimensions>&>(), declval<const Point<fixed_t,dimensions>&>(), declval<const int32_t*>(), declval<const float*>(), int32_t(0))))*);
+				template < typename type_t > static int8_t  test(...);
+
+			public:
+				static constexpr bool value = sizeof(test<processor_t>(nullptr)) == sizeof(int16_t); // True if the processor accepts index tables.
+			};
+
+			/// @brief Determines at compile-time if a processor needs to be told when scaling is done, i.e. if it can be called as `processor.finish()`.
+			/// @tparam processor_t The type of the processor function/functor.
+			template < typename processor_t >
+			class has_finish
+			{
+			private:
+				template < typename type_t > static int16_t test(decltype(void(declval<const type_t&>().finish()))*);
+				template < typename type_t > static int8_t  test(...);
+
+			public:
+				static constexpr bool value = sizeof(test<processor_t>(nullptr)) == sizeof(int16_t); // True if the processor has a finish function.
+			};
+
+			/// @brief Does nothing for processors that do not need to be told when scaling is done.
+			/// @tparam finishes Determines if the processor has a finish function.
+			template < bool finishes >
+			struct finisher
+			{
+				/// @brief Does nothing.
+				template < typename processor_t >
+				static void run(const processor_t&) {}
+			};
+
+			/// @brief Tells a processor that scaling is done.
+			template <>
+			struct finisher<true>
+			{
+				/// @brief Calls the finish function of a processor.
+				/// @tparam processor_t The type of the processor function/functor.
+				/// @param processor The processor.
+				template < typename processor_t >
+				static void run(const processor_t &processor) { processor.finish(); }
+			};
+
+			/// @brief Tells a processor that scaling is done, if it needs to be told.
+			/// @tparam processor_t The type of the processor function/functor.
+			/// @param processor The processor.
+			template < typename processor_t >
+			inline void finish(const processor_t &processor)
+			{
+				finisher<has_finish<processor_t>::value>::run(processor);
+			}
+
 			/// @brief A class used to iterate over multi-dimensional data recursively for each dimension and apply a processing function.
 			/// @tparam index The current index of the dimension being iterated over.
 			/// @tparam dimensions The number of dimensions to iterate over.
 			/// @tparam processor_t The type of the processor function/functor.
-			template < uint32_t index, uint32_t dimensions, typename processor_t >
+			/// @tparam fixed_t The fixed-point type of the source index.
+			/// @tparam rows Determines if the processor is handed entire rows of the innermost axis rather than single elements.
+			template < uint32_t index, uint32_t dimensions, typename processor_t, typename fixed_t = fixed32_t, bool rows = is_row_processor<processor_t,dimensions,fixed_t>::value >
 			class iterator
 			{
 			public:
@@ -214,10 +401,10 @@ namespace cc0
 				/// @param src_start The source offset (used for when the destination area was clipped as a result of the destination mask used at a previous stage in processing).
 				/// @param src_delta The delta used to iterate through the source index.
 				/// @param processor The processor function/functor to apply at each scale.
-				void operator()(Point<int32_t,dimensions> &dst_index, Point<fixed32_t,dimensions> &src_index, const Area<int32_t,dimensions> &dst_area, const Point<fixed32_t,dimensions> &src_start, const Point<fixed32_t,dimensions> &src_delta, const processor_t &processor) const
+				void operator()(Point<int32_t,dimensions> &dst_index, Point<fixed_t,dimensions> &src_index, const Area<int32_t,dimensions> &dst_area, const Point<fixed_t,dimensions> &src_start, const Point<fixed_t,dimensions> &src_delta, const processor_t &processor) const
 				{
 					for (dst_index[index] = dst_area.a[index], src_index[index] = src_start[index]; dst_index[index] < dst_area.b[index]; ++dst_index[index], src_index[index] += src_delta[index]) {
-						iterator<index-1,dimensions,processor_t>{}(dst_index, src_index, dst_area, src_start, src_delta, processor);
+						iterator<index-1,dimensions,processor_t,fixed_t>{}(dst_index, src_index, dst_area, src_start, src_delta, processor);
 					}
 				}
 			};
@@ -225,8 +412,9 @@ namespace cc0
 			/// @brief A class used to iterate over the final dimension of multi-dimensional data and apply a processing function.
 			/// @tparam dimensions The number of dimensions to iterate over.
 			/// @tparam processor_t The type of the processor function/functor.
-			template < uint32_t dimensions, typename processor_t >
-			class iterator<0, dimensions, processor_t>
+			/// @tparam fixed_t The fixed-point type of the source index.
+			template < uint32_t dimensions, typename processor_t, typename fixed_t >
+			class iterator<0, dimensions, processor_t, fixed_t, false>
 			{
 			public:
 				/// @brief Iterate over the final dimension in multi-dimensional data and apply a processing function at each scale.
@@ -236,116 +424,4217 @@ namespace cc0
 				/// @param src_start The source offset (used for when the destination area was clipped as a result of the destination mask used at a previous stage in processing).
 				/// @param src_delta The delta used to iterate through the source index.
 				/// @param processor The processor function/functor to apply at each scale.
-				void operator()(Point<int32_t,dimensions> &dst_index, Point<fixed32_t,dimensions> &src_index, const Area<int32_t,dimensions> &dst_area, const Point<fixed32_t,dimensions> &src_start, const Point<fixed32_t,dimensions> &src_delta, const processor_t &processor) const
+				void operator()(Point<int32_t,dimensions> &dst_index, Point<fixed_t,dimensions> &src_index, const Area<int32_t,dimensions> &dst_area, const Point<fixed_t,dimensions> &src_start, const Point<fixed_t,dimensions> &src_delta, const processor_t &processor) const
 				{
 					for (dst_index[0] = dst_area.a[0], src_index[0] = src_start[0]; dst_index[0] < dst_area.b[0]; ++dst_index[0], src_index[0] += src_delta[0]) {
 						processor(dst_index, src_index);
 					}
 				}
 			};
-		}
 
-		/// @brief Example processor functor that writes memory from one 1D array to another.
-		/// @tparam dst_t The type of the destination array.
-		/// @tparam src_t The type of the source array.
-		template < typename dst_t, typename src_t >
-		class write
-		{
-		private:
-			dst_t       *m_dst; // The destination array.
-			const src_t *m_src; // The source array.
-		
-		public:
-			/// @brief Creates a new write object.
-			/// @param dst The destination array.
-			/// @param src The source array.
-			write(dst_t *dst, const src_t *src) : m_dst(dst), m_src(src) {}
-			
-			/// @brief Writes to the destination array from the source array using the provided destination and source indices.
-			/// @param dst The destination array index.
-			/// @param src The source array index.
-			void operator()(const Point<int32_t,1> &dst, const Point<fixed32_t,1> &src)
+			/// @brief A class used to hand the final dimension of multi-dimensional data over to a row processor as a single run.
+			/// @tparam dimensions The number of dimensions to iterate over.
+			/// @tparam processor_t The type of the processor function/functor.
+			/// @tparam fixed_t The fixed-point type of the source index.
+			template < uint32_t dimensions, typename processor_t, typename fixed_t >
+			class iterator<0, dimensions, processor_t, fixed_t, true>
 			{
-				m_dst[dst[0]] = dst_t(m_src[int32_t(src[0])]);
-			}
-		};
+			public:
+				/// @brief Apply a processing function once to the entire run of the final dimension in multi-dimensional data.
+				/// @param dst_index An object containing the index of the destination.
+				/// @param src_index An object containing the index of the source.
+				/// @param dst_area The area over which to iterate the destination index.
+				/// @param src_start The source offset (used for when the destination area was clipped as a result of the destination mask used at a previous stage in processing).
+				/// @param src_delta The delta used to iterate through the source index.
+				/// @param processor The processor function/functor to apply to the row.
+				void operator()(Point<int32_t,dimensions> &dst_index, Point<fixed_t,dimensions> &src_index, const Area<int32_t,dimensions> &dst_area, const Point<fixed_t,dimensions> &src_start, const Point<fixed_t,dimensions> &src_delta, const processor_t &processor) const
+				{
+					dst_index[0] = dst_area.a[0];
+					src_index[0] = src_start[0];
+					processor(dst_index, src_index, src_delta, dst_area.b[0] - dst_area.a[0]);
+				}
+			};
 
-		/// @brief Scales a source area across a destination area and applies a processor function. Respects reversed axis sampling when an end point on an axis is less than the start point.
-		/// @tparam processor_t The type of the processor function. Will most usefully be a functor containing data to scale.
-		/// @tparam dimensions The number of dimensions of the space to iterate over.
-		/// @param dst_area The destination area to scale the source area over.
-		/// @param src_area The source area to scale over the destination area.
-		/// @param processor A function taking a destination index and a source index and performs computations. Can, for instance, be used to scale a source array to fit into a destination array.
-		/// @param dst_mask A mask used to discard all processing on the destination buffer that falls outside of the area. Can be used as a way to guard against sampling a destination array outside of accepted bounds, or allow for parallel processing by assigning different cores to different masks on the same destination array. In many cases using the bounds of the destination memory is desired.
-		/// @sa write
-		template < typename processor_t, uint32_t dimensions >
-		void scale(Area<int32_t,dimensions> dst_area, Area<fixed32_t,dimensions> src_area, const processor_t &processor, Area<int32_t,dimensions> dst_mask);
-	}
-}
+			/// @brief Determines at compile-time if two types are the same.
+			/// @tparam a_t The first type.
+			/// @tparam b_t The second type.
+			template < typename a_t, typename b_t >
+			struct is_same
+			{
+				static constexpr bool value = false; // True if the types are the same.
+			};
 
-/// @brief Addition.
-/// @tparam bits The total number of bits for the base data type. Supported sizes are 8, 16, 32, and 64.
-/// @tparam precision The number of bits dedicated to decimals.
-/// @param l The left-hand side operand.
-/// @param r The right-hand side operand.
-/// @return The result.
-template < uint32_t bits, uint32_t precision > inline cc0::scale::fixed<bits,precision> operator+(cc0::scale::fixed<bits,precision> l, cc0::scale::fixed<bits,precision> r) { return l += r; }
+			/// @brief Determines at compile-time if two types are the same.
+			/// @tparam type_t The type.
+			template < typename type_t >
+			struct is_same<type_t,type_t>
+			{
+				static constexpr bool value = true; // True if the types are the same.
+			};
 
-/// @brief Subtraction.
-/// @tparam bits The total number of bits for the base data type. Supported sizes are 8, 16, 32, and 64.
-/// @tparam precision The number of bits dedicated to decimals.
-/// @param l The left-hand side operand.
-/// @param r The right-hand side operand.
-/// @return The result.
-template < uint32_t bits, uint32_t precision > inline cc0::scale::fixed<bits,precision> operator-(cc0::scale::fixed<bits,precision> l, cc0::scale::fixed<bits,precision> r) { return l -= r; }
+			/// @brief Determines at compile-time if a processor returns a control value.
+			/// @tparam processor_t The type of the processor function/functor.
+			/// @tparam dimensions The number of dimensions to iterate over.
+			/// @tparam fixed_t The fixed-point type of the source index.
+			/// @tparam rows Determines if the processor is handed entire rows of the innermost axis rather than single elements.
+			template < typename processor_t, uint32_t dimensions, typename fixed_t = fixed32_t, bool rows = is_row_processor<processor_t,dimensions,fixed_t>::value >
+			struct returns_control
+			{
+				static constexpr bool value = is_same<decltype(declval<const processor_t&>()(declval<const Point<int32_t,dimensions>&>(), declval<const Point<fixed_t,dimensions>&>())),control>::value; // True if the processor returns a control value.
+			};
 
-/// @brief Multiplication.
-/// @tparam bits The total number of bits for the base data type. Supported sizes are 8, 16, 32, and 64.
-/// @tparam precision The number of bits dedicated to decimals.
-/// @param l The left-hand side operand.
-/// @param r The right-hand side operand.
-/// @return The result.
-template < uint32_t bits, uint32_t precision > inline cc0::scale::fixed<bits,precision> operator*(cc0::scale::fixed<bits,precision> l, cc0::scale::fixed<bits,precision> r) { return l *= r; }
+			/// @brief Determines at compile-time if a row processor returns a control value.
+			/// @tparam processor_t The type of the processor function/functor.
+			/// @tparam dimensions The number of dimensions to iterate over.
+			/// @tparam fixed_t The fixed-point type of the source index.
+			template < typename processor_t, uint32_t dimensions, typename fixed_t >
+			struct returns_control<processor_t,dimensions,fixed_t,true>
+			{
+				static constexpr bool value = is_same<decltype(declval<const processor_t&>()(declval<const Point<int32_t,dimensions>&>(), declval<const Point<fixed_t,dimensions>&>(), declval<const Point<fixed_t,dimensions>&>(), int32_t(0))),control>::value; // True if the processor returns a control value.
+			};
 
-/// @brief Division.
-/// @tparam bits The total number of bits for the base data type. Supported sizes are 8, 16, 32, and 64.
-/// @tparam precision The number of bits dedicated to decimals.
-/// @param l The left-hand side operand.
-/// @param r The right-hand side operand.
-/// @return The result.
-template < uint32_t bits, uint32_t precision > inline cc0::scale::fixed<bits,precision> operator/(cc0::scale::fixed<bits,precision> l, cc0::scale::fixed<bits,precision> r) { return l /= r; }
+			/// @brief Determines the return type of a processor driving other processors, which returns a control value only if one of the processors it drives does.
+			/// @tparam controls Determines if a driven processor returns a control value.
+			template < bool controls >
+			struct control_type
+			{
+				typedef void type; // The return type.
+			};
 
-template < typename processor_t, uint32_t dimensions >
-void cc0::scale::scale(cc0::scale::Area<int32_t,dimensions> dst_area, cc0::scale::Area<fixed32_t,dimensions> src_area, const processor_t &processor, cc0::scale::Area<int32_t,dimensions> dst_mask)
-{
-	for (uint32_t i = 0; i < dimensions; ++i) {
-		if (dst_mask.a[i] > dst_mask.b[i]) { internal::swap(dst_mask.a[i], dst_mask.b[i]); }
-	}
+			/// @brief Determines the return type of a processor driving other processors, of which at least one returns a control value.
+			template <>
+			struct control_type<true>
+			{
+				typedef control type; // The return type.
+			};
 
-	for (uint32_t i = 0; i < dimensions; ++i) {
-		if (dst_area.a[i] == dst_area.b[i]) { return; }
-		if (src_area.a[i] == src_area.b[i]) { return; }
-	}
-	Point<fixed32_t,dimensions> src_delta, src_start;
-	for (uint32_t i = 0; i < dimensions; ++i) {
-		if (dst_area.a[i] > dst_area.b[i]) {
-			internal::swap(dst_area.a[i], dst_area.b[i]);
-			internal::swap(src_area.a[i], src_area.b[i]);
-		}
-		if (dst_area.b[i] < dst_mask.a[i] || dst_area.a[i] >= dst_mask.b[i]) { return; }
-		src_delta[i].value_bits = (src_area.b[i].value_bits - src_area.a[i].value_bits) / (dst_area.b[i] - dst_area.a[i]);
-		src_start[i] = src_delta[i].value_bits >= 0 ? internal::min(src_area.a[i], src_area.b[i]) : (internal::max(src_area.a[i], src_area.b[i]) + src_delta[i]);
-		if (dst_area.a[i] < dst_mask.a[i]) {
-			src_start[i].value_bits += src_delta[i].value_bits * (dst_mask.a[i] - dst_area.a[i]);
-			dst_area.a[i] = dst_mask.a[i];
-		}
-		if (dst_area.b[i] >= dst_mask.b[i]) {
-			dst_area.b[i] = dst_mask.b[i];
+			/// @brief Calls a processor returning void and reports that processing should proceed.
+			/// @tparam controls Determines if the processor returns a control value.
+			template < bool controls >
+			struct invoke
+			{
+				/// @brief Calls the processor.
+				/// @tparam processor_t The type of the processor function/functor.
+				/// @tparam args_t The types of the arguments.
+				/// @param processor The processor.
+				/// @param args The arguments.
+				/// @return control::proceed.
+				template < typename processor_t, typename... args_t >
+				static control run(const processor_t &processor, const args_t&... args)
+				{
+					processor(args...);
+					return control::proceed;
+				}
+			};
+
+			/// @brief Calls a processor returning a control value.
+			template <>
+			struct invoke<true>
+			{
+				/// @brief Calls the processor.
+				/// @tparam processor_t The type of the processor function/functor.
+				/// @tparam args_t The types of the arguments.
+				/// @param processor The processor.
+				/// @param args The arguments.
+				/// @return The control value returned by the processor.
+				template < typename processor_t, typename... args_t >
+				static control run(const processor_t &processor, const args_t&... args)
+				{
+					return processor(args...);
+				}
+			};
+
+			/// @brief A class used to iterate over multi-dimensional data recursively for each dimension and apply a processing function that returns a control value.
+			/// @tparam index The current index of the dimension being iterated over.
+			/// @tparam dimensions The number of dimensions to iterate over.
+			/// @tparam processor_t The type of the processor function/functor.
+			/// @tparam fixed_t The fixed-point type of the source index.
+			/// @tparam rows Determines if the processor is handed entire rows of the innermost axis rather than single elements.
+			template < uint32_t index, uint32_t dimensions, typename processor_t, typename fixed_t = fixed32_t, bool rows = is_row_processor<processor_t,dimensions,fixed_t>::value >
+			class controlled_iterator
+			{
+			public:
+				/// @brief Recursively iterate over multi-dimensional data and apply a processing function at each scale.
+				/// @param dst_index An object containing the index of the destination.
+				/// @param src_index An object containing the index of the source.
+				/// @param dst_area The area over which to iterate the destination index.
+				/// @param src_start The source offset.
+				/// @param src_delta The delta used to iterate through the source index.
+				/// @param processor The processor function/functor to apply at each scale.
+				/// @return False if the processor stopped the traversal.
+				bool operator()(Point<int32_t,dimensions> &dst_index, Point<fixed_t,dimensions> &src_index, const Area<int32_t,dimensions> &dst_area, const Point<fixed_t,dimensions> &src_start, const Point<fixed_t,dimensions> &src_delta, const processor_t &processor) const
+				{
+					for (dst_index[index] = dst_area.a[index], src_index[index] = src_start[index]; dst_index[index] < dst_area.b[index]; ++dst_index[index], src_index[index] += src_delta[index]) {
+						if (!controlled_iterator<index-1,dimensions,processor_t,fixed_t>{}(dst_index, src_index, dst_area, src_start, src_delta, processor)) { return false; }
+					}
+					return true;
+				}
+			};
+
+			/// @brief A class used to iterate over the final dimension of multi-dimensional data and apply a processing function that returns a control value.
+			/// @tparam dimensions The number of dimensions to iterate over.
+			/// @tparam processor_t The type of the processor function/functor.
+			/// @tparam fixed_t The fixed-point type of the source index.
+			template < uint32_t dimensions, typename processor_t, typename fixed_t >
+			class controlled_iterator<0, dimensions, processor_t, fixed_t, false>
+			{
+			public:
+				/// @brief Iterate over the final dimension in multi-dimensional data and apply a processing function at each scale until it skips the row or stops.
+				/// @param dst_index An object containing the index of the destination.
+				/// @param src_index An object containing the index of the source.
+				/// @param dst_area The area over which to iterate the destination index.
+				/// @param src_start The source offset.
+				/// @param src_delta The delta used to iterate through the source index.
+				/// @param processor The processor function/functor to apply at each scale.
+				/// @return False if the processor stopped the traversal.
+				bool operator()(Point<int32_t,dimensions> &dst_index, Point<fixed_t,dimensions> &src_index, const Area<int32_t,dimensions> &dst_area, const Point<fixed_t,dimensions> &src_start, const Point<fixed_t,dimensions> &src_delta, const processor_t &processor) const
+				{
+					for (dst_index[0] = dst_area.a[0], src_index[0] = src_start[0]; dst_index[0] < dst_area.b[0]; ++dst_index[0], src_index[0] += src_delta[0]) {
+						const control c = processor(dst_index, src_index);
+						if (c == control::skip_row) { break; }
+						if (c == control::stop)     { return false; }
+					}
+					return true;
+				}
+			};
+
+			/// @brief A class used to hand the final dimension of multi-dimensional data over to a row processor that returns a control value as a single run.
+			/// @tparam dimensions The number of dimensions to iterate over.
+			/// @tparam processor_t The type of the processor function/functor.
+			/// @tparam fixed_t The fixed-point type of the source index.
+			template < uint32_t dimensions, typename processor_t, typename fixed_t >
+			class controlled_iterator<0, dimensions, processor_t, fixed_t, true>
+			{
+			public:
+				/// @brief Apply a processing function once to the entire run of the final dimension in multi-dimensional data.
+				/// @param dst_index An object containing the index of the destination.
+				/// @param src_index An object containing the index of the source.
+				/// @param dst_area The area over which to iterate the destination index.
+				/// @param src_start The source offset.
+				/// @param src_delta The delta used to iterate through the source index.
+				/// @param processor The processor function/functor to apply to the row.
+				/// @return False if the processor stopped the traversal.
+				bool operator()(Point<int32_t,dimensions> &dst_index, Point<fixed_t,dimensions> &src_index, const Area<int32_t,dimensions> &dst_area, const Point<fixed_t,dimensions> &src_start, const Point<fixed_t,dimensions> &src_delta, const processor_t &processor) const
+				{
+					dst_index[0] = dst_area.a[0];
+					src_index[0] = src_start[0];
+					return processor(dst_index, src_index, src_delta, dst_area.b[0] - dst_area.a[0]) != control::stop;
+				}
+			};
+
+			/// @brief Iterates over an area in row-major order with the iterator matching the return type of the processor.
+			/// @tparam controls Determines if the processor returns a control value.
+			template < bool controls >
+			struct row_major_iterator
+			{
+				/// @brief Iterates over an area with a processor returning void.
+				/// @tparam processor_t The type of the processor function/functor.
+				/// @tparam dimensions The number of dimensions to iterate over.
+				/// @tparam fixed_t The fixed-point type of the source index.
+				/// @param dst_area The area.
+				/// @param src_start The source index at the start of the area.
+				/// @param src_delta The delta used to iterate through the source index.
+				/// @param processor The processor function/functor to apply.
+				/// @return True.
+				template < typename processor_t, uint32_t dimensions, typename fixed_t >
+				static bool run(const Area<int32_t,dimensions> &dst_area, const Point<fixed_t,dimensions> &src_start, const Point<fixed_t,dimensions> &src_delta, const processor_t &processor)
+				{
+					Point<int32_t,dimensions> dst_index;
+					Point<fixed_t,dimensions> src_index;
+					iterator<dimensions-1,dimensions,processor_t,fixed_t>{}(dst_index, src_index, dst_area, src_start, src_delta, processor);
+					return true;
+				}
+			};
+
+			/// @brief Iterates over an area in row-major order with a processor returning a control value.
+			template <>
+			struct row_major_iterator<true>
+			{
+				/// @brief Iterates over an area with a processor returning a control value.
+				/// @tparam processor_t The type of the processor function/functor.
+				/// @tparam dimensions The number of dimensions to iterate over.
+				/// @tparam fixed_t The fixed-point type of the source index.
+				/// @param dst_area The area.
+				/// @param src_start The source index at the start of the area.
+				/// @param src_delta The delta used to iterate through the source index.
+				/// @param processor The processor function/functor to apply.
+				/// @return False if the processor stopped the traversal.
+				template < typename processor_t, uint32_t dimensions, typename fixed_t >
+				static bool run(const Area<int32_t,dimensions> &dst_area, const Point<fixed_t,dimensions> &src_start, const Point<fixed_t,dimensions> &src_delta, const processor_t &processor)
+				{
+					Point<int32_t,dimensions> dst_index;
+					Point<fixed_t,dimensions> src_index;
+					return controlled_iterator<dimensions-1,dimensions,processor_t,fixed_t>{}(dst_index, src_index, dst_area, src_start, src_delta, processor);
+				}
+			};
+
+			/// @brief The state needed to step through the source index along one axis without drift, using an integer step and a remainder accumulator.
+			/// @tparam fixed_t The fixed-point type of the source index.
+			template < typename fixed_t >
+			struct dda
+			{
+				fixed_t  start;     // The exact source index at the start of the clipped destination area, rounded down.
+				fixed_t  step;      // The source delta, rounded down.
+				uint64_t remainder; // The part of the source delta lost by rounding, in units of 1/divisor of the smallest fixed-point increment.
+				uint64_t divisor;   // The length of the destination area.
+				uint64_t error;     // The accumulated remainder at the start of the clipped destination area. 64 bits wide, since the remainder and the error can each come close to a divisor of 2^32 and their sum must not wrap.
+			};
+
+			/// @brief A class used to iterate over multi-dimensional data recursively for each dimension and apply a processing function, stepping through the source index without drift.
+			/// @tparam index The current index of the dimension being iterated over.
+			/// @tparam dimensions The number of dimensions to iterate over.
+			/// @tparam processor_t The type of the processor function/functor.
+			/// @tparam fixed_t The fixed-point type of the source index.
+			/// @tparam rows Determines if the processor is handed entire rows of the innermost axis rather than single elements.
+			template < uint32_t index, uint32_t dimensions, typename processor_t, typename fixed_t = fixed32_t, bool rows = is_row_processor<processor_t,dimensions,fixed_t>::value >
+			class exact_iterator
+			{
+			public:
+				/// @brief Recursively iterate over multi-dimensional data and apply a processing function at each scale.
+				/// @param dst_index An object containing the index of the destination.
+				/// @param src_index An object containing the index of the source.
+				/// @param dst_area The area over which to iterate the destination index.
+				/// @param step The stepping state of each axis.
+				/// @param processor The processor function/functor to apply at each scale.
+				/// @return False if the processor stopped the traversal.
+				bool operator()(Point<int32_t,dimensions> &dst_index, Point<fixed_t,dimensions> &src_index, const Area<int32_t,dimensions> &dst_area, const Point<dda<fixed_t>,dimensions> &step, const processor_t &processor) const
+				{
+					uint64_t error = step[index].error;
+					src_index[index] = step[index].start;
+					for (dst_index[index] = dst_area.a[index]; dst_index[index] < dst_area.b[index]; ++dst_index[index]) {
+						if (!exact_iterator<index-1,dimensions,processor_t,fixed_t>{}(dst_index, src_index, dst_area, step, processor)) { return false; }
+						src_index[index] += step[index].step;
+						error += step[index].remainder;
+						if (error >= step[index].divisor) {
+							error -= step[index].divisor;
+							++src_index[index].value_bits;
+						}
+					}
+					return true;
+				}
+			};
+
+			/// @brief A class used to iterate over the final dimension of multi-dimensional data and apply a processing function, stepping through the source index without drift.
+			/// @tparam dimensions The number of dimensions to iterate over.
+			/// @tparam processor_t The type of the processor function/functor.
+			/// @tparam fixed_t The fixed-point type of the source index.
+			template < uint32_t dimensions, typename processor_t, typename fixed_t >
+			class exact_iterator<0, dimensions, processor_t, fixed_t, false>
+			{
+			public:
+				/// @brief Iterate over the final dimension in multi-dimensional data and apply a processing function at each scale until it skips the row or stops.
+				/// @param dst_index An object containing the index of the destination.
+				/// @param src_index An object containing the index of the source.
+				/// @param dst_area The area over which to iterate the destination index.
+				/// @param step The stepping state of each axis.
+				/// @param processor The processor function/functor to apply at each scale.
+				/// @return False if the processor stopped the traversal.
+				bool operator()(Point<int32_t,dimensions> &dst_index, Point<fixed_t,dimensions> &src_index, const Area<int32_t,dimensions> &dst_area, const Point<dda<fixed_t>,dimensions> &step, const processor_t &processor) const
+				{
+					uint64_t error = step[0].error;
+					src_index[0] = step[0].start;
+					for (dst_index[0] = dst_area.a[0]; dst_index[0] < dst_area.b[0]; ++dst_index[0]) {
+						const control c = invoke<returns_control<processor_t,dimensions,fixed_t>::value>::run(processor, dst_index, src_index);
+						if (c == control::skip_row) { break; }
+						if (c == control::stop)     { return false; }
+						src_index[0] += step[0].step;
+						error += step[0].remainder;
+						if (error >= step[0].divisor) {
+							error -= step[0].divisor;
+							++src_index[0].value_bits;
+						}
+					}
+					return true;
+				}
+			};
+
+			/// @brief A class used to hand the final dimension of multi-dimensional data over to a row processor, stepping through the source index without drift. The run is handed over in a single call when the source delta is exact. Otherwise it is split into the longest runs over which the source index advances by a constant delta, which is the rounded down delta where the remainder carries less than every other element, and the rounded up delta where it carries more often.
+			/// @tparam dimensions The number of dimensions to iterate over.
+			/// @tparam processor_t The type of the processor function/functor.
+			/// @tparam fixed_t The fixed-point type of the source index.
+			template < uint32_t dimensions, typename processor_t, typename fixed_t >
+			class exact_iterator<0, dimensions, processor_t, fixed_t, true>
+			{
+			public:
+				/// @brief Apply a processing function to the run of the final dimension in multi-dimensional data.
+				/// @param dst_index An object containing the index of the destination.
+				/// @param src_index An object containing the index of the source.
+				/// @param dst_area The area over which to iterate the destination index.
+				/// @param step The stepping state of each axis.
+				/// @param processor The processor function/functor to apply to the row.
+				/// @return False if the processor stopped the traversal. The processor can stop after any of the runs a row is split into.
+				bool operator()(Point<int32_t,dimensions> &dst_index, Point<fixed_t,dimensions> &src_index, const Area<int32_t,dimensions> &dst_area, const Point<dda<fixed_t>,dimensions> &step, const processor_t &processor) const
+				{
+					typedef invoke<returns_control<processor_t,dimensions,fixed_t>::value> call;
+					Point<fixed_t,dimensions> src_delta;
+					for (uint32_t i = 0; i < dimensions; ++i) {
+						src_delta[i] = step[i].step;
+					}
+					dst_index[0] = dst_area.a[0];
+					src_index[0] = step[0].start;
+					if (step[0].remainder == 0) {
+						return call::run(processor, dst_index, src_index, src_delta, dst_area.b[0] - dst_area.a[0]) != control::stop;
+					}
+					const uint64_t remainder = step[0].remainder;
+					const uint64_t divisor   = step[0].divisor;
+					const bool     often     = 2 * remainder >= divisor;
+					src_delta[0].value_bits += often ? 1 : 0;
+					uint64_t error = step[0].error;
+					while (dst_index[0] < dst_area.b[0]) {
+						// Rarely carrying remainders keep the rounded down delta until the error reaches the divisor. Often carrying ones keep the rounded up delta until the error, which drops by divisor - remainder on every carry, would fall below it.
+						const uint64_t length = often ? error / (divisor - remainder) + 1 : (divisor - 1 - error) / remainder + 1;
+						const int32_t  count  = int32_t(internal::min(length, uint64_t(dst_area.b[0] - dst_index[0])));
+						if (call::run(processor, dst_index, src_index, src_delta, count) == control::stop) { return false; }
+						const uint64_t total = error + uint64_t(count) * remainder;
+						src_index[0] = internal::advance(src_index[0], step[0].step, count);
+						src_index[0].value_bits += typename fixed_t::int_t(total / divisor);
+						error = total % divisor;
+						dst_index[0] += count;
+					}
+					return true;
+				}
+			};
+		}
+
+		/// @brief For internal use only. Do not use.
+		namespace internal
+		{
+			/// @brief Returns the value at a given position in a list of values.
+			/// @param i The position.
+			/// @param v The value at the current position.
+			/// @return The value.
+			constexpr int32_t nth(uint32_t, int32_t v) { return v; }
+
+			/// @brief Returns the value at a given position in a list of values.
+			/// @tparam rest_t The types of the remaining values.
+			/// @param i The position.
+			/// @param v The value at the current position.
+			/// @param rest The remaining values.
+			/// @return The value.
+			template < typename... rest_t >
+			constexpr int32_t nth(uint32_t i, int32_t v, rest_t... rest) { return i == 0 ? v : nth(i - 1, rest...); }
+		}
+
+		/// @brief An area defined by a start-point and an end-point that are known at compile-time.
+		/// @tparam coordinates The coordinates of the start-point followed by the coordinates of the end-point.
+		/// @note Used to specialize scale for areas known at compile-time. Source areas are given in whole source elements.
+		template < int32_t... coordinates >
+		struct StaticArea
+		{
+			static_assert(sizeof...(coordinates) > 0 && sizeof...(coordinates) % 2 == 0, "A static area requires the same number of coordinates for the start-point and the end-point.");
+
+			static constexpr uint32_t dimensions = uint32_t(sizeof...(coordinates) / 2); // The number of dimensions of the area.
+
+			/// @brief Returns a coordinate of the start-point.
+			/// @param i The axis.
+			/// @return The coordinate.
+			static constexpr int32_t a(uint32_t i) { return internal::nth(i, coordinates...); }
+
+			/// @brief Returns a coordinate of the end-point.
+			/// @param i The axis.
+			/// @return The coordinate.
+			static constexpr int32_t b(uint32_t i) { return internal::nth(i + dimensions, coordinates...); }
+		};
+
+		/// @brief For internal use only. Do not use.
+		namespace internal
+		{
+			/// @brief The clipped destination area, source start, and source delta of a call to scale with static areas, all computed at compile-time using the same rules as scale.
+			/// @tparam dst_area_t The static destination area.
+			/// @tparam src_area_t The static source area.
+			/// @tparam dst_mask_t The static destination mask.
+			template < typename dst_area_t, typename src_area_t, typename dst_mask_t >
+			struct static_plan
+			{
+				static constexpr uint32_t dimensions = dst_area_t::dimensions; // The number of dimensions.
+				static constexpr int32_t  ONE        = int32_t(1) << 15;       // The bit pattern of 1.0 in the fixed-point format.
+
+				static constexpr bool    flip(uint32_t i)     { return dst_area_t::a(i) > dst_area_t::b(i); }
+				static constexpr int32_t dst_lo(uint32_t i)   { return flip(i) ? dst_area_t::b(i) : dst_area_t::a(i); }
+				static constexpr int32_t dst_hi(uint32_t i)   { return flip(i) ? dst_area_t::a(i) : dst_area_t::b(i); }
+				static constexpr int32_t src_a(uint32_t i)    { return (flip(i) ? src_area_t::b(i) : src_area_t::a(i)) * ONE; }
+				static constexpr int32_t src_b(uint32_t i)    { return (flip(i) ? src_area_t::a(i) : src_area_t::b(i)) * ONE; }
+				static constexpr int32_t mask_lo(uint32_t i)  { return dst_mask_t::a(i) < dst_mask_t::b(i) ? dst_mask_t::a(i) : dst_mask_t::b(i); }
+				static constexpr int32_t mask_hi(uint32_t i)  { return dst_mask_t::a(i) < dst_mask_t::b(i) ? dst_mask_t::b(i) : dst_mask_t::a(i); }
+				static constexpr int32_t lo(uint32_t i)       { return dst_lo(i) < mask_lo(i) ? mask_lo(i) : dst_lo(i); }
+				static constexpr int32_t hi(uint32_t i)       { return dst_hi(i) < mask_hi(i) ? dst_hi(i) : mask_hi(i); }
+				static constexpr int32_t delta(uint32_t i)    { return (src_b(i) - src_a(i)) / (dst_hi(i) - dst_lo(i)); }
+				static constexpr int32_t unclipped(uint32_t i){ return delta(i) >= 0 ? (src_a(i) < src_b(i) ? src_a(i) : src_b(i)) : (src_a(i) < src_b(i) ? src_b(i) : src_a(i)) + delta(i); }
+				static constexpr int32_t start(uint32_t i)    { return unclipped(i) + delta(i) * (lo(i) - dst_lo(i)); }
+				static constexpr bool    empty(uint32_t i)    { return dst_area_t::a(i) == dst_area_t::b(i) || src_area_t::a(i) == src_area_t::b(i) || dst_mask_t::a(i) == dst_mask_t::b(i) || dst_hi(i) <= mask_lo(i) || dst_lo(i) >= mask_hi(i); }
+				static constexpr bool    empty_from(uint32_t i) { return i < dimensions && (empty(i) || empty_from(i + 1)); }
+
+				static constexpr bool EMPTY = empty_from(0); // True if there is nothing to process.
+
+				static_assert(src_area_t::dimensions == dimensions && dst_mask_t::dimensions == dimensions, "All static areas must have the same number of dimensions.");
+			};
+
+			/// @brief Applies a processor to the elements of the innermost axis of a static plan. Each call is unrolled into straight-line code with the destination and source indices as immediate values.
+			/// @tparam plan_t The static plan.
+			/// @tparam processor_t The type of the processor function/functor.
+			/// @tparam i The index of the current element in the run.
+			/// @tparam count The number of elements in the run.
+			template < typename plan_t, typename processor_t, int32_t i, int32_t count >
+			struct static_unroll
+			{
+				/// @brief Applies the processor to the current element and all elements after it.
+				/// @param dst_index An object containing the index of the destination.
+				/// @param src_index An object containing the index of the source.
+				/// @param processor The processor function/functor to apply.
+				static void run(Point<int32_t,plan_t::dimensions> &dst_index, Point<fixed32_t,plan_t::dimensions> &src_index, const processor_t &processor)
+				{
+					static constexpr int32_t DST = plan_t::lo(0) + i;
+					static constexpr int32_t SRC = plan_t::start(0) + plan_t::delta(0) * i;
+					dst_index[0] = DST;
+					src_index[0].value_bits = SRC;
+					processor(dst_index, src_index);
+					static_unroll<plan_t, processor_t, i + 1, count>::run(dst_index, src_index, processor);
+				}
+			};
+
+			/// @brief Terminates the unrolled run.
+			/// @tparam plan_t The static plan.
+			/// @tparam processor_t The type of the processor function/functor.
+			/// @tparam count The number of elements in the run.
+			template < typename plan_t, typename processor_t, int32_t count >
+			struct static_unroll<plan_t, processor_t, count, count>
+			{
+				/// @brief Does nothing.
+				static void run(Point<int32_t,plan_t::dimensions>&, Point<fixed32_t,plan_t::dimensions>&, const processor_t&) {}
+			};
+
+			/// @brief Iterates over the axes of a static plan.
+			/// @tparam plan_t The static plan.
+			/// @tparam index The current index of the dimension being iterated over.
+			/// @tparam processor_t The type of the processor function/functor.
+			/// @tparam rows Determines if the processor is handed entire rows of the innermost axis rather than single elements.
+			template < typename plan_t, uint32_t index, typename processor_t, bool rows = is_row_processor<processor_t,plan_t::dimensions>::value >
+			struct static_iterator
+			{
+				/// @brief Iterates over the current axis.
+				/// @param dst_index An object containing the index of the destination.
+				/// @param src_index An object containing the index of the source.
+				/// @param processor The processor function/functor to apply.
+				static void run(Point<int32_t,plan_t::dimensions> &dst_index, Point<fixed32_t,plan_t::dimensions> &src_index, const processor_t &processor)
+				{
+					src_index[index].value_bits = plan_t::start(index);
+					for (dst_index[index] = plan_t::lo(index); dst_index[index] < plan_t::hi(index); ++dst_index[index], src_index[index].value_bits += plan_t::delta(index)) {
+						static_iterator<plan_t, index - 1, processor_t>::run(dst_index, src_index, processor);
+					}
+				}
+			};
+
+			/// @brief Iterates over the innermost axis of a static plan, elementwise.
+			/// @tparam plan_t The static plan.
+			/// @tparam processor_t The type of the processor function/functor.
+			template < typename plan_t, typename processor_t >
+			struct static_iterator<plan_t, 0, processor_t, false>
+			{
+				static constexpr int32_t COUNT  = plan_t::hi(0) - plan_t::lo(0); // The number of elements in the run.
+				static constexpr int32_t UNROLL = 64;                            // The longest run that is unrolled.
+
+				/// @brief Iterates over the innermost axis.
+				/// @param dst_index An object containing the index of the destination.
+				/// @param src_index An object containing the index of the source.
+				/// @param processor The processor function/functor to apply.
+				static void run(Point<int32_t,plan_t::dimensions> &dst_index, Point<fixed32_t,plan_t::dimensions> &src_index, const processor_t &processor)
+				{
+					static_unroll<plan_t, processor_t, 0, (COUNT <= UNROLL ? COUNT : 0)>::run(dst_index, src_index, processor);
+					if (COUNT > UNROLL) {
+						src_index[0].value_bits = plan_t::start(0);
+						for (dst_index[0] = plan_t::lo(0); dst_index[0] < plan_t::hi(0); ++dst_index[0], src_index[0].value_bits += plan_t::delta(0)) {
+							processor(dst_index, src_index);
+						}
+					}
+				}
+			};
+
+			/// @brief Hands the innermost axis of a static plan over to a row processor as a single run.
+			/// @tparam plan_t The static plan.
+			/// @tparam processor_t The type of the processor function/functor.
+			template < typename plan_t, typename processor_t >
+			struct static_iterator<plan_t, 0, processor_t, true>
+			{
+				/// @brief Applies the processor to the run.
+				/// @param dst_index An object containing the index of the destination.
+				/// @param src_index An object containing the index of the source.
+				/// @param processor The processor function/functor to apply.
+				static void run(Point<int32_t,plan_t::dimensions> &dst_index, Point<fixed32_t,plan_t::dimensions> &src_index, const processor_t &processor)
+				{
+					Point<fixed32_t,plan_t::dimensions> src_delta;
+					for (uint32_t i = 0; i < plan_t::dimensions; ++i) {
+						src_delta[i].value_bits = plan_t::delta(i);
+					}
+					dst_index[0] = plan_t::lo(0);
+					src_index[0].value_bits = plan_t::start(0);
+					processor(dst_index, src_index, src_delta, plan_t::hi(0) - plan_t::lo(0));
+				}
+			};
+
+			/// @brief Runs a static plan, unless it is empty.
+			/// @tparam plan_t The static plan.
+			/// @tparam processor_t The type of the processor function/functor.
+			/// @tparam empty True if there is nothing to process.
+			/// @tparam controls Determines if the processor returns a control value.
+			template < typename plan_t, typename processor_t, bool empty = plan_t::EMPTY, bool controls = returns_control<processor_t,plan_t::dimensions>::value >
+			struct static_scale
+			{
+				/// @brief Runs the plan.
+				/// @param processor The processor function/functor to apply.
+				static void run(const processor_t &processor)
+				{
+					Point<int32_t,plan_t::dimensions> dst_index;
+					Point<fixed32_t,plan_t::dimensions> src_index;
+					static_iterator<plan_t, plan_t::dimensions - 1, processor_t>::run(dst_index, src_index, processor);
+					finish(processor);
+				}
+			};
+
+			/// @brief Runs a static plan with a processor returning a control value. The unrolled code cannot stop early, so the area, source start, and source delta computed at compile-time are iterated over at run-time by the same iterator as row_major.
+			/// @tparam plan_t The static plan.
+			/// @tparam processor_t The type of the processor function/functor.
+			template < typename plan_t, typename processor_t >
+			struct static_scale<plan_t, processor_t, false, true>
+			{
+				/// @brief Runs the plan.
+				/// @param processor The processor function/functor to apply.
+				static void run(const processor_t &processor)
+				{
+					Area<int32_t,plan_t::dimensions> dst_area;
+					Point<fixed32_t,plan_t::dimensions> src_start, src_delta;
+					for (uint32_t i = 0; i < plan_t::dimensions; ++i) {
+						dst_area.a[i] = plan_t::lo(i);
+						dst_area.b[i] = plan_t::hi(i);
+						src_start[i].value_bits = plan_t::start(i);
+						src_delta[i].value_bits = plan_t::delta(i);
+					}
+					row_major_iterator<true>::run(dst_area, src_start, src_delta, processor);
+					finish(processor);
+				}
+			};
+
+			/// @brief Does nothing for empty static plans.
+			/// @tparam plan_t The static plan.
+			/// @tparam processor_t The type of the processor function/functor.
+			/// @tparam controls Determines if the processor returns a control value.
+			template < typename plan_t, typename processor_t, bool controls >
+			struct static_scale<plan_t, processor_t, true, controls>
+			{
+				/// @brief Does nothing.
+				static void run(const processor_t&) {}
+			};
+		}
+
+		/// @brief For internal use only. Do not use.
+		namespace internal
+		{
+			/// @brief The relationship between a source delta and a single source element.
+			enum class ratio
+			{
+				general,   // The delta is not a whole multiple, or a whole fraction, of a single source element.
+				integer,   // Every step skips exactly k source elements.
+				reciprocal // Every source element is stepped over exactly k times.
+			};
+
+			/// @brief Determines if a source delta represents an exact integer, or exact reciprocal integer, ratio.
+			/// @param src_delta The delta used to iterate through the source index.
+			/// @param k Receives the magnitude of the integer, or the integer of the reciprocal. Left untouched for general ratios.
+			/// @return The ratio.
+			/// @note Only power-of-two reciprocals are exactly representable in the fixed-point format. Other reciprocals are general ratios, as the truncated delta drifts away from the repeating pattern over long runs.
+			inline ratio classify(fixed32_t src_delta, int32_t &k)
+			{
+				const int32_t one = fixed32_t(1).value_bits;
+				const int32_t d   = src_delta.value_bits < 0 ? -src_delta.value_bits : src_delta.value_bits;
+				if (d == 0)       { return ratio::general; }
+				if (d % one == 0) { k = d / one; return ratio::integer; }
+				if (one % d == 0) { k = one / d; return ratio::reciprocal; }
+				return ratio::general;
+			}
+
+			/// @brief Provides the size of element types that SIMD kernels can copy as raw bits.
+			/// @tparam type_t The element type.
+			/// @note The size is zero for types that can not be copied by SIMD kernels.
+			template < typename type_t > struct simd_info           { static constexpr uint32_t size = 0; };
+			template <>                  struct simd_info<char>     { static constexpr uint32_t size = 1; };
+			template <>                  struct simd_info<int8_t>   { static constexpr uint32_t size = 1; };
+			template <>                  struct simd_info<uint8_t>  { static constexpr uint32_t size = 1; };
+			template <>                  struct simd_info<int16_t>  { static constexpr uint32_t size = 2; };
+			template <>                  struct simd_info<uint16_t> { static constexpr uint32_t size = 2; };
+			template <>                  struct simd_info<int32_t>  { static constexpr uint32_t size = 4; };
+			template <>                  struct simd_info<uint32_t> { static constexpr uint32_t size = 4; };
+			template <>                  struct simd_info<float>    { static constexpr uint32_t size = 4; };
+
+#if defined(CC0_SCALE_SSE2)
+			typedef __m128i simd128_t; // A 128-bit SIMD register.
+
+			/// @brief Loads 128 unaligned bits.
+			/// @param p The address to load from.
+			/// @return The loaded bits.
+			inline simd128_t simd_load(const void *p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+
+			/// @brief Stores 128 unaligned bits.
+			/// @param p The address to store to.
+			/// @param v The bits to store.
+			inline void simd_store(void *p, simd128_t v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+
+			/// @brief Shuffles used to stretch and shrink runs by a factor of two. `lo` and `hi` duplicate each element in the lower and upper half of a register into two adjacent elements, while `even` packs every other element of two registers into one.
+			/// @tparam size The size of the elements in bytes.
+			template < uint32_t size > struct simd_shuffle {};
+			template <> struct simd_shuffle<1> { static simd128_t lo(simd128_t v) { return _mm_unpacklo_epi8(v, v); }  static simd128_t hi(simd128_t v) { return _mm_unpackhi_epi8(v, v); }  static simd128_t even(simd128_t a, simd128_t b) { const __m128i m = _mm_set1_epi16(0xff); return _mm_packus_epi16(_mm_and_si128(a, m), _mm_and_si128(b, m)); } };
+			template <> struct simd_shuffle<2> { static simd128_t lo(simd128_t v) { return _mm_unpacklo_epi16(v, v); } static simd128_t hi(simd128_t v) { return _mm_unpackhi_epi16(v, v); } static simd128_t even(simd128_t a, simd128_t b) { return _mm_packs_epi32(_mm_srai_epi32(_mm_slli_epi32(a, 16), 16), _mm_srai_epi32(_mm_slli_epi32(b, 16), 16)); } };
+			template <> struct simd_shuffle<4> { static simd128_t lo(simd128_t v) { return _mm_unpacklo_epi32(v, v); } static simd128_t hi(simd128_t v) { return _mm_unpackhi_epi32(v, v); } static simd128_t even(simd128_t a, simd128_t b) { return _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b), _MM_SHUFFLE(2, 0, 2, 0))); } };
+#elif defined(CC0_SCALE_NEON)
+			typedef uint8x16_t simd128_t; // A 128-bit SIMD register.
+
+			/// @brief Loads 128 unaligned bits.
+			/// @param p The address to load from.
+			/// @return The loaded bits.
+			inline simd128_t simd_load(const void *p) { return vld1q_u8(static_cast<const uint8_t*>(p)); }
+
+			/// @brief Stores 128 unaligned bits.
+			/// @param p The address to store to.
+			/// @param v The bits to store.
+			inline void simd_store(void *p, simd128_t v) { vst1q_u8(static_cast<uint8_t*>(p), v); }
+
+			/// @brief Shuffles used to stretch and shrink runs by a factor of two. `lo` and `hi` duplicate each element in the lower and upper half of a register into two adjacent elements, while `even` packs every other element of two registers into one.
+			/// @tparam size The size of the elements in bytes.
+			template < uint32_t size > struct simd_shuffle {};
+			template <> struct simd_shuffle<1> { static simd128_t lo(simd128_t v) { return vzipq_u8(v, v).val[0]; } static simd128_t hi(simd128_t v) { return vzipq_u8(v, v).val[1]; } static simd128_t even(simd128_t a, simd128_t b) { return vuzpq_u8(a, b).val[0]; } };
+			template <> struct simd_shuffle<2> { static simd128_t lo(simd128_t v) { uint16x8_t w = vreinterpretq_u16_u8(v); return vreinterpretq_u8_u16(vzipq_u16(w, w).val[0]); } static simd128_t hi(simd128_t v) { uint16x8_t w = vreinterpretq_u16_u8(v); return vreinterpretq_u8_u16(vzipq_u16(w, w).val[1]); } static simd128_t even(simd128_t a, simd128_t b) { return vreinterpretq_u8_u16(vuzpq_u16(vreinterpretq_u16_u8(a), vreinterpretq_u16_u8(b)).val[0]); } };
+			template <> struct simd_shuffle<4> { static simd128_t lo(simd128_t v) { uint32x4_t w = vreinterpretq_u32_u8(v); return vreinterpretq_u8_u32(vzipq_u32(w, w).val[0]); } static simd128_t hi(simd128_t v) { uint32x4_t w = vreinterpretq_u32_u8(v); return vreinterpretq_u8_u32(vzipq_u32(w, w).val[1]); } static simd128_t even(simd128_t a, simd128_t b) { return vreinterpretq_u8_u32(vuzpq_u32(vreinterpretq_u32_u8(a), vreinterpretq_u32_u8(b)).val[0]); } };
+#endif
+
+#if defined(CC0_SCALE_AVX2)
+			/// @brief Gathers elements from arbitrary source indices into a destination run.
+			/// @tparam size The size of the elements in bytes.
+			/// @note Elements smaller than 32 bits are gathered as 32-bit words, so the gather reads up to 32 bits past (or, for reversed runs, before) the sampled element.
+			template < uint32_t size > class simd_gather {};
+
+			/// @brief Gathers 32-bit elements.
+			template <>
+			class simd_gather<4>
+			{
+			public:
+				static constexpr int32_t LANES = 8; // The number of elements written per chunk.
+				static constexpr int32_t OVER  = 0; // The number of elements read past the sampled element.
+
+				/// @brief Gathers a chunk of elements.
+				/// @param dst The destination run.
+				/// @param src The source array.
+				/// @param idx The source indices of the first eight elements.
+				static void chunk(void *dst, const void *src, __m256i idx, __m256i, bool)
+				{
+					_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), _mm256_i32gather_epi32(static_cast<const int*>(src), idx, 4));
+				}
+			};
+
+			/// @brief Gathers 16-bit elements.
+			template <>
+			class simd_gather<2>
+			{
+			public:
+				static constexpr int32_t LANES = 8; // The number of elements written per chunk.
+				static constexpr int32_t OVER  = 1; // The number of elements read past the sampled element.
+
+				/// @brief Gathers a chunk of elements.
+				/// @param dst The destination run.
+				/// @param src The source array.
+				/// @param idx The source indices of the first eight elements.
+				/// @param reversed True if the indices were offset backwards so that the element resides in the upper half of the gathered word.
+				static void chunk(void *dst, const void *src, __m256i idx, __m256i, bool reversed)
+				{
+					__m256i v = _mm256_i32gather_epi32(static_cast<const int*>(src), idx, 2);
+					v = reversed ? _mm256_srli_epi32(v, 16) : _mm256_and_si256(v, _mm256_set1_epi32(0xffff));
+					v = _mm256_permute4x64_epi64(_mm256_packus_epi32(v, v), 0x08);
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm256_castsi256_si128(v));
+				}
+			};
+
+			/// @brief Gathers 8-bit elements.
+			template <>
+			class simd_gather<1>
+			{
+			public:
+				static constexpr int32_t LANES = 16; // The number of elements written per chunk.
+				static constexpr int32_t OVER  = 3;  // The number of elements read past the sampled element.
+
+				/// @brief Gathers a chunk of elements.
+				/// @param dst The destination run.
+				/// @param src The source array.
+				/// @param idx0 The source indices of the first eight elements.
+				/// @param idx1 The source indices of the last eight elements.
+				/// @param reversed True if the indices were offset backwards so that the element resides in the upper byte of the gathered word.
+				static void chunk(void *dst, const void *src, __m256i idx0, __m256i idx1, bool reversed)
+				{
+					__m256i v0 = _mm256_i32gather_epi32(static_cast<const int*>(src), idx0, 1);
+					__m256i v1 = _mm256_i32gather_epi32(static_cast<const int*>(src), idx1, 1);
+					if (reversed) {
+						v0 = _mm256_srli_epi32(v0, 24);
+						v1 = _mm256_srli_epi32(v1, 24);
+					} else {
+						v0 = _mm256_and_si256(v0, _mm256_set1_epi32(0xff));
+						v1 = _mm256_and_si256(v1, _mm256_set1_epi32(0xff));
+					}
+					__m256i v = _mm256_packus_epi32(v0, v1);
+					v = _mm256_permutevar8x32_epi32(_mm256_packus_epi16(v, v), _mm256_setr_epi32(0, 4, 1, 5, 0, 4, 1, 5));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm256_castsi256_si128(v));
+				}
+			};
+#endif
+
+			/// @brief SIMD kernels for nearest-neighbor copies of an entire run of elements.
+			/// @tparam type_t The element type.
+			/// @tparam size The size of the element type in bytes, or zero if the type can not be copied by SIMD kernels.
+			template < typename type_t, uint32_t size = simd_info<type_t>::size >
+			class simd_write
+			{
+			private:
+				static constexpr int32_t ONE = int32_t(1) << 15; // The bit pattern of 1.0 in the fixed-point format.
+
+			public:
+				/// @brief Writes as much of a run as the available SIMD kernels allow.
+				/// @param dst The first element of the destination run.
+				/// @param src The source array.
+				/// @param src_start The source index of the first element in the run.
+				/// @param src_delta The delta used to iterate through the source index.
+				/// @param count The number of elements in the run.
+				/// @return The number of elements written, always starting from the first element.
+				static int32_t row(type_t *dst, const type_t *src, fixed32_t src_start, fixed32_t src_delta, int32_t count)
+				{
+					int32_t n = 0;
+#if !defined(CC0_SCALE_SSE2) && !defined(CC0_SCALE_NEON)
+					(void)dst; (void)src; (void)src_start; (void)src_delta; (void)count;
+#else
+					static constexpr int32_t LANES = int32_t(16 / size);
+					if (src_delta.value_bits == ONE) {
+						const type_t *in = src + int32_t(src_start);
+						for (; n + LANES <= count; n += LANES) {
+							simd_store(dst + n, simd_load(in + n));
+						}
+						return n;
+					}
+					if (src_delta.value_bits == ONE / 2) {
+						if ((src_start.value_bits & (ONE / 2)) != 0) { // The run starts on the second half of a source element.
+							if (count <= 0) { return 0; }
+							dst[0] = src[int32_t(src_start)];
+							src_start += src_delta;
+							n = 1;
+						}
+						const type_t *in = src + int32_t(src_start);
+						for (; n + 2 * LANES <= count; n += 2 * LANES, in += LANES) {
+							const simd128_t v = simd_load(in);
+							simd_store(dst + n, simd_shuffle<size>::lo(v));
+							simd_store(dst + n + LANES, simd_shuffle<size>::hi(v));
+						}
+						return n;
+					}
+					if (src_delta.value_bits == ONE * 2) {
+						// The chunk reads one element past its last sample, so always leave at least one sample after the chunk.
+						const type_t *in = src + int32_t(src_start);
+						for (; n + LANES < count; n += LANES, in += 2 * LANES) {
+							simd_store(dst + n, simd_shuffle<size>::even(simd_load(in), simd_load(in + LANES)));
+						}
+						return n;
+					}
+#endif
+#if defined(CC0_SCALE_AVX2)
+					if (count < simd_gather<size>::LANES) { return 0; }
+					// The gather over-reads small elements, so only gather chunks whose final word stays inside the sampled index range of the run.
+					const bool    reversed = src_delta.value_bits < 0;
+					const int32_t last     = int32_t((int64_t(src_start.value_bits) + int64_t(src_delta.value_bits) * (count - 1)) >> 15);
+					const int32_t over     = reversed ? -simd_gather<size>::OVER : simd_gather<size>::OVER;
+					const __m256i offset   = _mm256_set1_epi32(reversed ? simd_gather<size>::OVER : 0);
+					const __m256i delta8   = _mm256_set1_epi32(src_delta.value_bits * 8);
+					__m256i s = _mm256_add_epi32(_mm256_set1_epi32(src_start.value_bits), _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(src_delta.value_bits)));
+					for (; n + simd_gather<size>::LANES <= count; n += simd_gather<size>::LANES) {
+						const int32_t end = int32_t((int64_t(src_start.value_bits) + int64_t(src_delta.value_bits) * (n + simd_gather<size>::LANES - 1)) >> 15) + over;
+						if (reversed ? end < last : end > last) { break; }
+						const __m256i s1 = _mm256_add_epi32(s, delta8);
+						simd_gather<size>::chunk(dst + n, src, _mm256_sub_epi32(_mm256_srai_epi32(s, 15), offset), _mm256_sub_epi32(_mm256_srai_epi32(s1, 15), offset), reversed);
+						s = simd_gather<size>::LANES == 8 ? s1 : _mm256_add_epi32(s1, delta8);
+					}
+#endif
+					return n;
+				}
+			};
+
+			/// @brief Scalar fallback for element types that can not be copied by SIMD kernels.
+			/// @tparam type_t The element type.
+			template < typename type_t >
+			class simd_write<type_t, 0>
+			{
+			public:
+				/// @brief Writes nothing.
+				/// @return Zero.
+				static int32_t row(type_t*, const type_t*, fixed32_t, fixed32_t, int32_t) { return 0; }
+			};
+
+			/// @brief Writes an entire run from one array to another using nearest-neighbor sampling without SIMD kernels. Integer and reciprocal integer deltas avoid fixed-point stepping altogether.
+			/// @tparam dst_t The type of the destination array.
+			/// @tparam src_t The type of the source array.
+			/// @param dst The first element of the destination run.
+			/// @param src The source array.
+			/// @param src_start The source index of the first element in the run.
+			/// @param src_delta The delta used to iterate through the source index.
+			/// @param count The number of elements in the run.
+			template < typename dst_t, typename src_t >
+			inline void write_run(dst_t *dst, const src_t *src, fixed32_t src_start, fixed32_t src_delta, int32_t count)
+			{
+				int32_t k;
+				switch (classify(src_delta, k)) {
+				case ratio::integer: {
+					const src_t   *in   = src + int32_t(src_start);
+					const int32_t  step = src_delta.value_bits < 0 ? -k : k;
+					for (int32_t i = 0; i < count; ++i) {
+						dst[i] = dst_t(in[i * step]);
+					}
+					break;
+				}
+				case ratio::reciprocal: {
+					// Every source element is repeated k times, except the first which is repeated until the fractional part of the source index wraps.
+					const int32_t d    = src_delta.value_bits < 0 ? -src_delta.value_bits : src_delta.value_bits;
+					const int32_t f    = src_start.value_bits & (fixed32_t(1).value_bits - 1);
+					const int32_t step = src_delta.value_bits < 0 ? -1 : 1;
+					int32_t       run  = src_delta.value_bits < 0 ? f / d + 1 : k - f / d;
+					const src_t  *in   = src + int32_t(src_start);
+					for (int32_t i = 0; i < count; in += step, run = k) {
+						const dst_t v = dst_t(*in);
+						for (const int32_t end = min(i + run, count); i < end; ++i) {
+							dst[i] = v;
+						}
+					}
+					break;
+				}
+				default:
+					for (int32_t i = 0; i < count; ++i, src_start += src_delta) {
+						dst[i] = dst_t(src[int32_t(src_start)]);
+					}
+					break;
+				}
+			}
+
+			/// @brief Writes an entire run from one array to another using nearest-neighbor sampling.
+			/// @tparam dst_t The type of the destination array.
+			/// @tparam src_t The type of the source array.
+			/// @param dst The first element of the destination run.
+			/// @param src The source array.
+			/// @param src_start The source index of the first element in the run.
+			/// @param src_delta The delta used to iterate through the source index.
+			/// @param count The number of elements in the run.
+			template < typename dst_t, typename src_t >
+			inline void write_row(dst_t *dst, const src_t *src, fixed32_t src_start, fixed32_t src_delta, int32_t count)
+			{
+				write_run(dst, src, src_start, src_delta, count);
+			}
+
+			/// @brief Writes an entire run from one array to another array of the same type using nearest-neighbor sampling, using SIMD kernels where available.
+			/// @tparam type_t The type of the arrays.
+			/// @param dst The first element of the destination run.
+			/// @param src The source array.
+			/// @param src_start The source index of the first element in the run.
+			/// @param src_delta The delta used to iterate through the source index.
+			/// @param count The number of elements in the run.
+			template < typename type_t >
+			inline void write_row(type_t *dst, const type_t *src, fixed32_t src_start, fixed32_t src_delta, int32_t count)
+			{
+				const int32_t n = simd_write<type_t>::row(dst, src, src_start, src_delta, count);
+				src_start.value_bits += src_delta.value_bits * n;
+				write_run(dst + n, src, src_start, src_delta, count - n);
+			}
+
+			/// @brief Converts fixed-point formats other than fixed32_t to fixed32_t where that loses nothing, so that their runs can use the kernels of fixed32_t.
+			/// @tparam fixed_t The fixed-point type.
+			template < typename fixed_t >
+			struct widen
+			{
+				static constexpr bool value = false; // True if every number of the format is exactly representable in fixed32_t.
+			};
+
+			/// @brief Formats narrower than 32 bits with at most 15 fractional bits, such as fixed<16,8>, are exactly representable in fixed32_t.
+			/// @tparam bits The total number of bits of the format.
+			/// @tparam precision The number of fractional bits of the format.
+			template < uint32_t bits, uint32_t precision >
+			struct widen< fixed<bits,precision> >
+			{
+				static constexpr bool value = bits < 32 && precision <= 15 && bits - precision <= 17; // True if every number of the format is exactly representable in fixed32_t.
+
+				/// @brief Converts a number to fixed32_t.
+				/// @param f The number.
+				/// @return The same number in fixed32_t.
+				static fixed32_t run(fixed<bits,precision> f)
+				{
+					fixed32_t w;
+					w.value_bits = int32_t(f.value_bits) * (int32_t(1) << (15 - precision));
+					return w;
+				}
+			};
+
+			/// @brief Writes an entire run from one array to another using nearest-neighbor sampling and a fixed-point format that can not be converted to fixed32_t, one element at a time.
+			/// @tparam widened Determines if the format converts to fixed32_t, in which case the run goes through the kernels of fixed32_t instead.
+			template < bool widened >
+			struct write_fixed
+			{
+				/// @brief Writes an entire run.
+				/// @tparam dst_t The type of the destination array.
+				/// @tparam src_t The type of the source array.
+				/// @tparam fixed_t The fixed-point type of the source index.
+				/// @param dst The first element of the destination run.
+				/// @param src The source array.
+				/// @param src_start The source index of the first element in the run.
+				/// @param src_delta The delta used to iterate through the source index.
+				/// @param count The number of elements in the run.
+				template < typename dst_t, typename src_t, typename fixed_t >
+				static void run(dst_t *dst, const src_t *src, fixed_t src_start, fixed_t src_delta, int32_t count)
+				{
+					for (int32_t i = 0; i < count; ++i, src_start += src_delta) {
+						dst[i] = dst_t(src[int32_t(src_start)]);
+					}
+				}
+			};
+
+			/// @brief Writes an entire run using a fixed-point format that converts to fixed32_t, through the kernels of fixed32_t.
+			template <>
+			struct write_fixed<true>
+			{
+				/// @brief Writes an entire run.
+				/// @tparam dst_t The type of the destination array.
+				/// @tparam src_t The type of the source array.
+				/// @tparam fixed_t The fixed-point type of the source index.
+				/// @param dst The first element of the destination run.
+				/// @param src The source array.
+				/// @param src_start The source index of the first element in the run.
+				/// @param src_delta The delta used to iterate through the source index.
+				/// @param count The number of elements in the run.
+				template < typename dst_t, typename src_t, typename fixed_t >
+				static void run(dst_t *dst, const src_t *src, fixed_t src_start, fixed_t src_delta, int32_t count)
+				{
+					write_row(dst, src, widen<fixed_t>::run(src_start), widen<fixed_t>::run(src_delta), count);
+				}
+			};
+
+			/// @brief Writes an entire run from one array to another using nearest-neighbor sampling and a fixed-point format other than fixed32_t.
+			/// @tparam dst_t The type of the destination array.
+			/// @tparam src_t The type of the source array.
+			/// @tparam fixed_t The fixed-point type of the source index.
+			/// @param dst The first element of the destination run.
+			/// @param src The source array.
+			/// @param src_start The source index of the first element in the run.
+			/// @param src_delta The delta used to iterate through the source index.
+			/// @param count The number of elements in the run.
+			template < typename dst_t, typename src_t, typename fixed_t >
+			inline void write_row(dst_t *dst, const src_t *src, fixed_t src_start, fixed_t src_delta, int32_t count)
+			{
+				write_fixed<widen<fixed_t>::value>::run(dst, src, src_start, src_delta, count);
+			}
+
+			/// @brief Writes rows using regular stores.
+			/// @tparam streaming Determines if non-temporal stores are used where the destination is aligned.
+			template < bool streaming >
+			struct store_row
+			{
+				/// @brief Writes an entire run.
+				/// @tparam dst_t The type of the destination array.
+				/// @tparam src_t The type of the source array.
+				/// @tparam fixed_t The fixed-point type of the source index.
+				/// @param dst The first element of the destination run.
+				/// @param src The source array.
+				/// @param src_start The source index of the first element in the run.
+				/// @param src_delta The delta used to iterate through the source index.
+				/// @param count The number of elements in the run.
+				template < typename dst_t, typename src_t, typename fixed_t >
+				static void run(dst_t *dst, const src_t *src, fixed_t src_start, fixed_t src_delta, int32_t count)
+				{
+					write_row(dst, src, src_start, src_delta, count);
+				}
+
+				/// @brief Does nothing, since regular stores need no fence.
+				static void fence( void ) {}
+			};
+
+			/// @brief Writes rows using non-temporal stores where the destination is aligned, bypassing the cache for destinations too large to benefit from it.
+			template <>
+			struct store_row<true>
+			{
+				/// @brief Writes an entire run. Elements up to the first 16-byte boundary and after the last one are written with regular stores. The elements in between are written to a buffer in the cache a chunk at a time, which is then streamed to the destination.
+				/// @tparam dst_t The type of the destination array.
+				/// @tparam src_t The type of the source array.
+				/// @tparam fixed_t The fixed-point type of the source index.
+				/// @param dst The first element of the destination run.
+				/// @param src The source array.
+				/// @param src_start The source index of the first element in the run.
+				/// @param src_delta The delta used to iterate through the source index.
+				/// @param count The number of elements in the run.
+				/// @note Falls back to regular stores for targets without non-temporal stores, and for elements that do not evenly divide 16 bytes.
+				template < typename dst_t, typename src_t, typename fixed_t >
+				static void run(dst_t *dst, const src_t *src, fixed_t src_start, fixed_t src_delta, int32_t count)
+				{
+#if defined(CC0_SCALE_SSE2)
+					static constexpr int32_t SIZE  = int32_t(sizeof(dst_t));
+					static constexpr int32_t CHUNK = SIZE <= 256 ? 256 / SIZE : 1; // The number of elements written to the buffer at a time.
+					const int32_t misalignment = int32_t(reinterpret_cast<uintptr_t>(dst) & 15);
+					if (16 % SIZE == 0 && misalignment % SIZE == 0) {
+						const int32_t head = ((16 - misalignment) & 15) / SIZE;
+						if (count - head >= 16 / SIZE) {
+							write_row(dst, src, src_start, src_delta, head);
+							dst += head;
+							count -= head;
+							src_start.value_bits += src_delta.value_bits * head;
+							alignas(16) dst_t buffer[CHUNK];
+							while (count >= 16 / SIZE) {
+								const int32_t n = (count < CHUNK ? count : CHUNK) / (16 / SIZE) * (16 / SIZE);
+								write_row(buffer, src, src_start, src_delta, n);
+								for (int32_t i = 0; i < n; i += 16 / SIZE) {
+									_mm_stream_si128(reinterpret_cast<__m128i*>(dst + i), _mm_load_si128(reinterpret_cast<const __m128i*>(buffer + i)));
+								}
+								dst += n;
+								count -= n;
+								src_start.value_bits += src_delta.value_bits * n;
+							}
+						}
+					}
+#endif
+					write_row(dst, src, src_start, src_delta, count);
+				}
+
+				/// @brief Orders non-temporal stores before any later stores, so that the destination is complete once scaling is done.
+				static void fence( void )
+				{
+#if defined(CC0_SCALE_SSE2)
+					_mm_sfence();
+#endif
+				}
+			};
+
+			/// @brief Converts a filtered value to the destination type, rounding to the nearest integer for integer types.
+			/// @tparam type_t The destination type.
+			template < typename type_t >
+			struct filtered
+			{
+				/// @brief Converts a value.
+				/// @param v The value.
+				/// @return The converted value.
+				static type_t from(float v) { return type_t(v < 0.0f ? v - 0.5f : v + 0.5f); }
+			};
+
+			/// @brief Converts a filtered value to float.
+			template <>
+			struct filtered<float>
+			{
+				/// @brief Converts a value.
+				/// @param v The value.
+				/// @return The converted value.
+				static float from(float v) { return v; }
+			};
+
+			/// @brief Converts a filtered value to double.
+			template <>
+			struct filtered<double>
+			{
+				/// @brief Converts a value.
+				/// @param v The value.
+				/// @return The converted value.
+				static double from(float v) { return double(v); }
+			};
+
+			/// @brief Clamps an index to the bounds of an axis.
+			/// @param i The index.
+			/// @param size The number of elements along the axis.
+			/// @return The clamped index.
+			inline int32_t clamp_index(int32_t i, int32_t size)
+			{
+				return i < 0 ? 0 : (i >= size ? size - 1 : i);
+			}
+
+			/// @brief Finds the elements of a run whose fixed-point bits stay in the range [0, limit), where source indices need no clamping.
+			/// @param x The bits of the first element in the run.
+			/// @param d The bits added to step from one element to the next.
+			/// @param count The number of elements in the run.
+			/// @param limit The end of the range.
+			/// @param lo Receives the first element inside of the range.
+			/// @param hi Receives the end of the elements inside of the range, no less than lo.
+			/// @note Since the bits step linearly, the elements inside of the range are contiguous.
+			inline void interior(int64_t x, int64_t d, int32_t count, int64_t limit, int32_t &lo, int32_t &hi)
+			{
+				int64_t l = 0, h = count;
+				if (d > 0) {
+					l = x >= 0 ? 0 : (-x + d - 1) / d;
+					h = x < limit ? (limit - x + d - 1) / d : 0;
+				} else if (d < 0) {
+					l = x < limit ? 0 : (x - limit) / -d + 1;
+					h = x >= 0 ? x / -d + 1 : 0;
+				} else if (x < 0 || x >= limit) {
+					h = 0;
+				}
+				h = h < count ? h : count;
+				l = l < h ? l : h;
+				lo = int32_t(l);
+				hi = int32_t(h);
+			}
+
+			/// @brief The two source elements and their weights along one axis used for linear interpolation.
+			struct linear_taps
+			{
+				static constexpr int32_t ONE  = int32_t(1) << 15; // The bit pattern of 1.0 in the fixed-point format.
+				static constexpr int32_t MASK = ONE - 1;          // The fractional bits of the fixed-point format.
+
+				int32_t offset[2]; // The offsets of the source elements.
+				float   weight[2]; // The weights of the source elements.
+
+				/// @brief Moves a source index to the center of its destination element, less half a source element, so that its integer part is the first of the two source elements interpolated between and its fraction is the weight of the second.
+				/// @param src The source index of the destination element.
+				/// @param src_delta The delta used to iterate through the source index.
+				/// @return The bit pattern of the moved source index.
+				static int32_t center(fixed32_t src, fixed32_t src_delta)
+				{
+					const int32_t d = src_delta.value_bits < 0 ? -src_delta.value_bits : src_delta.value_bits;
+					return src.value_bits + d / 2 - ONE / 2;
+				}
+
+				/// @brief Computes the source elements and weights for the center of a destination element.
+				/// @param src The source index of the destination element.
+				/// @param src_delta The delta used to iterate through the source index.
+				/// @param size The number of source elements along the axis.
+				/// @param stride The number of source elements between two adjacent indices along the axis.
+				void set(fixed32_t src, fixed32_t src_delta, int32_t size, int32_t stride)
+				{
+					const int32_t x = center(src, src_delta);
+					const int32_t i = x >> 15;
+					const float   f = float(x & MASK) * (1.0f / ONE);
+					offset[0] = clamp_index(i, size) * stride;
+					offset[1] = clamp_index(i + 1, size) * stride;
+					weight[0] = 1.0f - f;
+					weight[1] = f;
+				}
+			};
+
+			/// @brief The range of source elements and their coverage along one axis used for box filtering.
+			struct box_span
+			{
+				static constexpr int32_t ONE = int32_t(1) << 15; // The bit pattern of 1.0 in the fixed-point format.
+
+				int32_t a;     // The start of the covered source range.
+				int32_t b;     // The end of the covered source range.
+				int32_t first; // The first source element in range.
+				int32_t last;  // The last source element in range.
+				float   scale; // The reciprocal of the length of the range.
+
+				/// @brief Computes the range of source elements covered by a destination element.
+				/// @param src The source index of the destination element.
+				/// @param src_delta The delta used to iterate through the source index.
+				void set(fixed32_t src, fixed32_t src_delta)
+				{
+					int32_t d = src_delta.value_bits < 0 ? -src_delta.value_bits : src_delta.value_bits;
+					d = d > 0 ? d : 1;
+					a = src.value_bits;
+					b = a + d;
+					first = a >> 15;
+					last = (b - 1) >> 15;
+					scale = 1.0f / float(d);
+				}
+
+				/// @brief Returns the largest number of source elements a range can cover along an axis.
+				/// @param src_delta The delta used to iterate through the source index.
+				/// @return The number of source elements.
+				static int32_t taps(fixed32_t src_delta)
+				{
+					const int32_t d = src_delta.value_bits < 0 ? -src_delta.value_bits : src_delta.value_bits;
+					return (d + ONE - 1) / ONE + 1;
+				}
+
+				/// @brief Returns the weight of a source element, i.e. the part of the range it covers.
+				/// @param j The source element.
+				/// @return The weight.
+				float weight(int32_t j) const
+				{
+					const int32_t lo = j * ONE, hi = lo + ONE;
+					return float((b < hi ? b : hi) - (a > lo ? a : lo)) * scale;
+				}
+			};
+
+			/// @brief The two source elements nearest to the center of a destination element along one axis and their weights used for linear interpolation.
+			struct linear_span
+			{
+				static constexpr int32_t ONE  = int32_t(1) << 15; // The bit pattern of 1.0 in the fixed-point format.
+				static constexpr int32_t MASK = ONE - 1;          // The fractional bits of the fixed-point format.
+
+				int32_t first;    // The first source element.
+				int32_t last;     // The last source element.
+				float   fraction; // The weight of the last source element.
+
+				/// @brief Computes the source elements nearest to the center of a destination element.
+				/// @param src The source index of the destination element.
+				/// @param src_delta The delta used to iterate through the source index.
+				void set(fixed32_t src, fixed32_t src_delta)
+				{
+					const int32_t x = linear_taps::center(src, src_delta);
+					first = x >> 15;
+					last = first + 1;
+					fraction = float(x & MASK) * (1.0f / ONE);
+				}
+
+				/// @brief Returns the largest number of source elements interpolated between along an axis.
+				/// @return The number of source elements.
+				static int32_t taps(fixed32_t) { return 2; }
+
+				/// @brief Returns the weight of a source element.
+				/// @param j The source element.
+				/// @return The weight.
+				float weight(int32_t j) const { return j == first ? 1.0f - fraction : fraction; }
+			};
+
+			/// @brief The source element nearest to a destination element, as sampled by write.
+			struct nearest_span
+			{
+				int32_t first; // The source element.
+				int32_t last;  // The source element.
+
+				/// @brief Computes the source element of a destination element.
+				/// @param src The source index of the destination element.
+				void set(fixed32_t src, fixed32_t)
+				{
+					first = last = src.value_bits >> 15;
+				}
+
+				/// @brief Returns the largest number of source elements sampled along an axis.
+				/// @return The number of source elements.
+				static int32_t taps(fixed32_t) { return 1; }
+
+				/// @brief Returns the weight of a source element.
+				/// @return The weight.
+				float weight(int32_t) const { return 1.0f; }
+			};
+
+			/// @brief Averages the source elements covered by spans along all axes.
+			/// @tparam src_t The type of the source array.
+			/// @tparam dimensions The number of dimensions of the source array.
+			/// @tparam clamp Whether the spans may reach outside of the source array, in which case indices are clamped to its edges.
+			/// @param src The source array.
+			/// @param stride The number of source elements between two adjacent indices on each axis.
+			/// @param size The number of source elements along each axis.
+			/// @param span The covered range along each axis.
+			/// @return The average.
+			template < typename src_t, uint32_t dimensions, bool clamp = true >
+			inline float box_sample(const src_t *src, const Point<int32_t,dimensions> &stride, const Point<int32_t,dimensions> &size, const box_span (&span)[dimensions])
+			{
+				int32_t j[dimensions];
+				for (uint32_t i = 0; i < dimensions; ++i) {
+					j[i] = span[i].first;
+				}
+				float sum = 0.0f;
+				for (;;) {
+					float   w = 1.0f;
+					int32_t o = 0;
+					for (uint32_t i = 0; i < dimensions; ++i) {
+						w *= span[i].weight(j[i]);
+						o += (clamp ? clamp_index(j[i], size[i]) : j[i]) * stride[i];
+					}
+					sum += w * float(src[o]);
+					uint32_t i = 0;
+					for (; i < dimensions; ++i) {
+						if (++j[i] <= span[i].last) { break; }
+						j[i] = span[i].first;
+					}
+					if (i == dimensions) { break; }
+				}
+				return sum;
+			}
+
+			/// @brief Averages a block of whole source elements, all with the same weight. Elements are accumulated in the same order as by box_sample, so that both produce the same result for the same block.
+			/// @tparam src_t The type of the source array.
+			/// @tparam dimensions The number of dimensions of the source array.
+			/// @param src The first source element of the block.
+			/// @param stride The number of source elements between two adjacent indices on each axis.
+			/// @param size The number of source elements in the block along each axis.
+			/// @param weight The weight of each element.
+			/// @return The weighted sum.
+			template < typename src_t, uint32_t dimensions >
+			inline float block_sample(const src_t *src, const Point<int32_t,dimensions> &stride, const int32_t (&size)[dimensions], float weight)
+			{
+				int32_t j[dimensions] = { 0 };
+				float sum = 0.0f;
+				for (;;) {
+					for (int32_t x = 0; x < size[0]; ++x) {
+						sum += weight * float(src[x * stride[0]]);
+					}
+					uint32_t i = 1;
+					for (; i < dimensions; ++i) {
+						src += stride[i];
+						if (++j[i] < size[i]) { break; }
+						src -= j[i] * stride[i];
+						j[i] = 0;
+					}
+					if (i >= dimensions) { break; }
+				}
+				return sum;
+			}
+		}
+
+		/// @brief Store policy for write that writes the destination using regular stores, leaving it in the cache. The default.
+		struct cached_stores {};
+
+		/// @brief Store policy for write that writes the destination using non-temporal stores, bypassing the cache. Useful when the destination is much larger than the cache and is not read back soon, since it avoids evicting the source and reading destination lines only to overwrite them.
+		/// @note Only rows along a tightly packed innermost axis are streamed, and only between their first and last 16-byte boundaries. Elements at the edges of rows, e.g. where the destination mask clipped a row to an unaligned start, use regular stores. Stores are fenced when scaling is done.
+		struct streaming_stores {};
+
+		/// @brief Example processor functor that writes memory from one multi-dimensional array to another.
+		/// @tparam dst_t The type of the destination array.
+		/// @tparam src_t The type of the source array.
+		/// @tparam dimensions The number of dimensions of the arrays.
+		/// @tparam store_t The store policy, either cached_stores or streaming_stores.
+		template < typename dst_t, typename src_t, uint32_t dimensions = 1, typename store_t = cached_stores >
+		class write
+		{
+		private:
+			dst_t                     *m_dst;        // The destination array.
+			const src_t               *m_src;        // The source array.
+			Point<int32_t,dimensions>  m_dst_stride; // The number of destination elements between two adjacent indices on each axis.
+			Point<int32_t,dimensions>  m_src_stride; // The number of source elements between two adjacent indices on each axis.
+
+		public:
+			/// @brief Creates a new write object for tightly packed 1D arrays.
+			/// @param dst The destination array.
+			/// @param src The source array.
+			write(dst_t *dst, const src_t *src) : m_dst(dst), m_src(src)
+			{
+				static_assert(dimensions == 1, "Arrays with more than one dimension require strides.");
+				m_dst_stride[0] = 1;
+				m_src_stride[0] = 1;
+			}
+
+			/// @brief Creates a new write object.
+			/// @param dst The destination array.
+			/// @param dst_stride The number of destination elements between two adjacent indices on each axis. For a tightly packed 2D image this is { 1, width }.
+			/// @param src The source array.
+			/// @param src_stride The number of source elements between two adjacent indices on each axis. For a tightly packed 2D image this is { 1, width }.
+			write(dst_t *dst, const Point<int32_t,dimensions> &dst_stride, const src_t *src, const Point<int32_t,dimensions> &src_stride) : m_dst(dst), m_src(src), m_dst_stride(dst_stride), m_src_stride(src_stride) {}
+
+			/// @brief Writes to the destination array from the source array using the provided destination and source indices.
+			/// @tparam fixed_t The fixed-point type of the source index.
+			/// @param dst The destination array index.
+			/// @param src The source array index.
+			template < typename fixed_t >
+			void operator()(const Point<int32_t,dimensions> &dst, const Point<fixed_t,dimensions> &src) const
+			{
+				int32_t d = 0, s = 0;
+				for (uint32_t i = 0; i < dimensions; ++i) {
+					d += dst[i] * m_dst_stride[i];
+					s += int32_t(src[i]) * m_src_stride[i];
+				}
+				m_dst[d] = dst_t(m_src[s]);
+			}
+
+			/// @brief Writes an entire run to the destination array from the source array starting at the provided destination and source indices.
+			/// @tparam fixed_t The fixed-point type of the source index.
+			/// @param dst The destination array index of the first element in the run.
+			/// @param src The source array index of the first element in the run.
+			/// @param src_delta The delta used to iterate through the source index.
+			/// @param count The number of elements in the run.
+			/// @note The offsets of the outer axes are computed once per run, leaving only the innermost axis in the loop over elements.
+			template < typename fixed_t >
+			void operator()(const Point<int32_t,dimensions> &dst, const Point<fixed_t,dimensions> &src, const Point<fixed_t,dimensions> &src_delta, int32_t count) const
+			{
+				dst_t       *out = m_dst;
+				const src_t *in  = m_src;
+				for (uint32_t i = 1; i < dimensions; ++i) {
+					out += dst[i] * m_dst_stride[i];
+					in  += int32_t(src[i]) * m_src_stride[i];
+				}
+				if (m_dst_stride[0] == 1 && m_src_stride[0] == 1) {
+					internal::store_row<internal::is_same<store_t,streaming_stores>::value>::run(out + dst[0], in, src[0], src_delta[0], count);
+				} else {
+					out += dst[0] * m_dst_stride[0];
+					fixed_t s = src[0];
+					for (int32_t i = 0; i < count; ++i, out += m_dst_stride[0], s += src_delta[0]) {
+						*out = dst_t(in[int32_t(s) * m_src_stride[0]]);
+					}
+				}
+			}
+
+			/// @brief Writes an entire run to the destination array from the source array using a precomputed table of source offsets along the innermost axis.
+			/// @tparam fixed_t The fixed-point type of the source index.
+			/// @param dst The destination array index of the first element in the run.
+			/// @param src The source array index of the first element in the run.
+			/// @param src_delta The delta used to iterate through the source index.
+			/// @param index The source offsets of the elements in the run, as computed by tabulate.
+			/// @param count The number of elements in the run.
+			/// @note Tables only replace the stepping of strided rows. Rows that are tightly packed in both arrays ignore the table and go through the same SIMD kernels and store policy as without one, since those are faster than gathering through the table.
+			template < typename fixed_t >
+			void operator()(const Point<int32_t,dimensions> &dst, const Point<fixed_t,dimensions> &src, const Point<fixed_t,dimensions> &src_delta, const int32_t *index, const float*, int32_t count) const
+			{
+				dst_t       *out = m_dst;
+				const src_t *in  = m_src;
+				for (uint32_t i = 1; i < dimensions; ++i) {
+					out += dst[i] * m_dst_stride[i];
+					in  += int32_t(src[i]) * m_src_stride[i];
+				}
+				if (m_dst_stride[0] == 1 && m_src_stride[0] == 1) {
+					internal::store_row<internal::is_same<store_t,streaming_stores>::value>::run(out + dst[0], in, src[0], src_delta[0], count);
+					return;
+				}
+				out += dst[0] * m_dst_stride[0];
+				if (m_dst_stride[0] == 1) {
+					for (int32_t i = 0; i < count; ++i) {
+						out[i] = dst_t(in[index[i]]);
+					}
+				} else {
+					for (int32_t i = 0; i < count; ++i, out += m_dst_stride[0]) {
+						*out = dst_t(in[index[i]]);
+					}
+				}
+			}
+
+			/// @brief Computes the source offsets of a run along the innermost axis.
+			/// @tparam fixed_t The fixed-point type of the source index.
+			/// @param src_start The source index of the first element in the run.
+			/// @param src_delta The delta used to iterate through the source index.
+			/// @param count The number of elements in the run.
+			/// @param index Receives the source offset of each element.
+			/// @return True. No weights are used.
+			template < typename fixed_t >
+			bool tabulate(fixed_t src_start, fixed_t src_delta, int32_t count, int32_t *index, float*) const
+			{
+				for (int32_t i = 0; i < count; ++i, src_start += src_delta) {
+					index[i] = int32_t(src_start) * m_src_stride[0];
+				}
+				return true;
+			}
+
+			/// @brief Fences the non-temporal stores of the streaming_stores policy. Called when scaling is done.
+			void finish( void ) const
+			{
+				internal::store_row<internal::is_same<store_t,streaming_stores>::value>::fence();
+			}
+		};
+
+		/// @brief Processor functor that writes memory from one multi-dimensional array to another using linear interpolation between the source elements nearest to the center of each destination element.
+		/// @tparam dst_t The type of the destination array.
+		/// @tparam src_t The type of the source array.
+		/// @tparam dimensions The number of dimensions of the arrays.
+		/// @note Source indices outside of the source array are clamped to its edges.
+		template < typename dst_t, typename src_t, uint32_t dimensions = 1 >
+		class write_linear
+		{
+		private:
+			static constexpr uint32_t CORNERS = uint32_t(1) << (dimensions - 1); // The number of source elements interpolated between along the outer axes.
+
+			dst_t                     *m_dst;        // The destination array.
+			const src_t               *m_src;        // The source array.
+			Point<int32_t,dimensions>  m_dst_stride; // The number of destination elements between two adjacent indices on each axis.
+			Point<int32_t,dimensions>  m_src_stride; // The number of source elements between two adjacent indices on each axis.
+			Point<int32_t,dimensions>  m_src_size;   // The number of source elements along each axis.
+
+			/// @brief Writes part of a run along the innermost axis.
+			/// @tparam clamp Whether the source elements may lie outside of the source array, in which case indices are clamped to its edges.
+			/// @param out The destination of the first element. Advanced past the last element.
+			/// @param x The bits of the source index of the first element, offset to sample at its center. Advanced past the last element.
+			/// @param d The bits added to step from one element to the next.
+			/// @param count The number of elements.
+			/// @param offset The offsets of the source elements interpolated between along the outer axes.
+			/// @param weight The weights of the source elements interpolated between along the outer axes.
+			template < bool clamp >
+			void steps(dst_t *&out, int32_t &x, int32_t d, int32_t count, const int32_t (&offset)[CORNERS], const float (&weight)[CORNERS]) const
+			{
+				for (int32_t n = 0; n < count; ++n, out += m_dst_stride[0], x += d) {
+					const int32_t i  = x >> 15;
+					const float   f  = float(x & internal::linear_taps::MASK) * (1.0f / internal::linear_taps::ONE);
+					const int32_t i0 = (clamp ? internal::clamp_index(i, m_src_size[0]) : i) * m_src_stride[0];
+					const int32_t i1 = clamp ? internal::clamp_index(i + 1, m_src_size[0]) * m_src_stride[0] : i0 + m_src_stride[0];
+					float sum = 0.0f;
+					for (uint32_t c = 0; c < CORNERS; ++c) {
+						const src_t *in = m_src + offset[c];
+						sum += weight[c] * (float(in[i0]) + (float(in[i1]) - float(in[i0])) * f);
+					}
+					*out = internal::filtered<dst_t>::from(sum);
+				}
+			}
+
+		public:
+			/// @brief Creates a new write_linear object for tightly packed 1D arrays.
+			/// @param dst The destination array.
+			/// @param src The source array.
+			/// @param src_size The number of elements in the source array.
+			write_linear(dst_t *dst, const src_t *src, int32_t src_size) : m_dst(dst), m_src(src)
+			{
+				static_assert(dimensions == 1, "Arrays with more than one dimension require strides.");
+				m_dst_stride[0] = 1;
+				m_src_stride[0] = 1;
+				m_src_size[0] = src_size;
+			}
+
+			/// @brief Creates a new write_linear object.
+			/// @param dst The destination array.
+			/// @param dst_stride The number of destination elements between two adjacent indices on each axis.
+			/// @param src The source array.
+			/// @param src_stride The number of source elements between two adjacent indices on each axis.
+			/// @param src_size The number of source elements along each axis.
+			write_linear(dst_t *dst, const Point<int32_t,dimensions> &dst_stride, const src_t *src, const Point<int32_t,dimensions> &src_stride, const Point<int32_t,dimensions> &src_size) : m_dst(dst), m_src(src), m_dst_stride(dst_stride), m_src_stride(src_stride), m_src_size(src_size) {}
+
+			/// @brief Writes an entire run to the destination array starting at the provided destination and source indices.
+			/// @param dst The destination array index of the first element in the run.
+			/// @param src The source array index of the first element in the run.
+			/// @param src_delta The delta used to iterate through the source index.
+			/// @param count The number of elements in the run.
+			/// @note The source elements and weights of the outer axes are computed once per run, and the weights of the innermost axis are stepped using the fractional bits of the source index. Indices are only clamped near the edges of the source array.
+			void operator()(const Point<int32_t,dimensions> &dst, const Point<fixed32_t,dimensions> &src, const Point<fixed32_t,dimensions> &src_delta, int32_t count) const
+			{
+				int32_t offset[CORNERS];
+				float   weight[CORNERS];
+				offset[0] = 0;
+				weight[0] = 1.0f;
+				uint32_t corners = 1;
+				for (uint32_t i = 1; i < dimensions; ++i) {
+					internal::linear_taps taps;
+					taps.set(src[i], src_delta[i], m_src_size[i], m_src_stride[i]);
+					for (uint32_t c = 0; c < corners; ++c) {
+						offset[c + corners] = offset[c] + taps.offset[1];
+						weight[c + corners] = weight[c] * taps.weight[1];
+						offset[c] += taps.offset[0];
+						weight[c] *= taps.weight[0];
+					}
+					corners *= 2;
+				}
+				dst_t *out = m_dst;
+				for (uint32_t i = 0; i < dimensions; ++i) {
+					out += dst[i] * m_dst_stride[i];
+				}
+				int32_t x = internal::linear_taps::center(src[0], src_delta[0]);
+				int32_t lo, hi;
+				internal::interior(x, src_delta[0].value_bits, count, int64_t(m_src_size[0] - 1) * internal::linear_taps::ONE, lo, hi);
+				steps<true>(out, x, src_delta[0].value_bits, lo, offset, weight);
+				steps<false>(out, x, src_delta[0].value_bits, hi - lo, offset, weight);
+				steps<true>(out, x, src_delta[0].value_bits, count - hi, offset, weight);
+			}
+
+			/// @brief Writes an entire run to the destination array using precomputed tables of source offsets and weights along the innermost axis.
+			/// @param dst The destination array index of the first element in the run.
+			/// @param src The source array index of the first element in the run. Only the outer axes are used.
+			/// @param src_delta The delta used to iterate through the source index. Only the outer axes are used.
+			/// @param index The offsets of the first of the two source elements interpolated between, as computed by tabulate.
+			/// @param weight The weights of the second of the two source elements interpolated between, as computed by tabulate.
+			/// @param count The number of elements in the run.
+			void operator()(const Point<int32_t,dimensions> &dst, const Point<fixed32_t,dimensions> &src, const Point<fixed32_t,dimensions> &src_delta, const int32_t *index, const float *weight, int32_t count) const
+			{
+				int32_t offset[CORNERS];
+				float   corner[CORNERS];
+				offset[0] = 0;
+				corner[0] = 1.0f;
+				uint32_t corners = 1;
+				for (uint32_t i = 1; i < dimensions; ++i) {
+					internal::linear_taps taps;
+					taps.set(src[i], src_delta[i], m_src_size[i], m_src_stride[i]);
+					for (uint32_t c = 0; c < corners; ++c) {
+						offset[c + corners] = offset[c] + taps.offset[1];
+						corner[c + corners] = corner[c] * taps.weight[1];
+						offset[c] += taps.offset[0];
+						corner[c] *= taps.weight[0];
+					}
+					corners *= 2;
+				}
+				dst_t *out = m_dst;
+				for (uint32_t i = 0; i < dimensions; ++i) {
+					out += dst[i] * m_dst_stride[i];
+				}
+				const int32_t step = m_src_size[0] > 1 ? m_src_stride[0] : 0;
+				for (int32_t n = 0; n < count; ++n, out += m_dst_stride[0]) {
+					const float f = weight[n];
+					float sum = 0.0f;
+					for (uint32_t c = 0; c < CORNERS; ++c) {
+						const src_t *in = m_src + offset[c] + index[n];
+						sum += corner[c] * (float(in[0]) + (float(in[step]) - float(in[0])) * f);
+					}
+					*out = internal::filtered<dst_t>::from(sum);
+				}
+			}
+
+			/// @brief Computes the source offsets and weights of a run along the innermost axis.
+			/// @param src_start The source index of the first element in the run.
+			/// @param src_delta The delta used to iterate through the source index.
+			/// @param count The number of elements in the run.
+			/// @param index Receives the offset of the first of the two source elements interpolated between for each element. Clamping to the edges of the source array is folded into the offsets and weights.
+			/// @param weight Receives the weight of the second of the two source elements interpolated between for each element.
+			/// @return False if no weight table was provided.
+			bool tabulate(fixed32_t src_start, fixed32_t src_delta, int32_t count, int32_t *index, float *weight) const
+			{
+				if (weight == nullptr) { return false; }
+				int32_t x = internal::linear_taps::center(src_start, src_delta);
+				for (int32_t n = 0; n < count; ++n, x += src_delta.value_bits) {
+					const int32_t i = x >> 15;
+					if (i < 0 || m_src_size[0] < 2) {
+						index[n] = 0;
+						weight[n] = 0.0f;
+					} else if (i >= m_src_size[0] - 1) {
+						index[n] = (m_src_size[0] - 2) * m_src_stride[0];
+						weight[n] = 1.0f;
+					} else {
+						index[n] = i * m_src_stride[0];
+						weight[n] = float(x & internal::linear_taps::MASK) * (1.0f / internal::linear_taps::ONE);
+					}
+				}
+				return true;
+			}
+		};
+
+		/// @brief Processor functor that writes memory from one multi-dimensional array to another by averaging all source elements covered by each destination element, weighted by coverage. Useful for downscaling without aliasing.
+		/// @tparam dst_t The type of the destination array.
+		/// @tparam src_t The type of the source array.
+		/// @tparam dimensions The number of dimensions of the arrays.
+		/// @note When upscaling, each destination element covers at most two source elements along each axis, and they are blended by coverage.
+		template < typename dst_t, typename src_t, uint32_t dimensions = 1 >
+		class write_box
+		{
+		private:
+			dst_t                     *m_dst;        // The destination array.
+			const src_t               *m_src;        // The source array.
+			Point<int32_t,dimensions>  m_dst_stride; // The number of destination elements between two adjacent indices on each axis.
+			Point<int32_t,dimensions>  m_src_stride; // The number of source elements between two adjacent indices on each axis.
+			Point<int32_t,dimensions>  m_src_size;   // The number of source elements along each axis.
+
+		public:
+			/// @brief Creates a new write_box object for tightly packed 1D arrays.
+			/// @param dst The destination array.
+			/// @param src The source array.
+			/// @param src_size The number of elements in the source array.
+			write_box(dst_t *dst, const src_t *src, int32_t src_size) : m_dst(dst), m_src(src)
+			{
+				static_assert(dimensions == 1, "Arrays with more than one dimension require strides.");
+				m_dst_stride[0] = 1;
+				m_src_stride[0] = 1;
+				m_src_size[0] = src_size;
+			}
+
+			/// @brief Creates a new write_box object.
+			/// @param dst The destination array.
+			/// @param dst_stride The number of destination elements between two adjacent indices on each axis.
+			/// @param src The source array.
+			/// @param src_stride The number of source elements between two adjacent indices on each axis.
+			/// @param src_size The number of source elements along each axis.
+			write_box(dst_t *dst, const Point<int32_t,dimensions> &dst_stride, const src_t *src, const Point<int32_t,dimensions> &src_stride, const Point<int32_t,dimensions> &src_size) : m_dst(dst), m_src(src), m_dst_stride(dst_stride), m_src_stride(src_stride), m_src_size(src_size) {}
+
+		private:
+			/// @brief Writes an entire run where every destination element covers a block of whole source elements inside of the source array, such as exact 2x or 4x shrinks, in which case all weights are equal and no indices need clamping.
+			/// @param dst The destination array index of the first element in the run.
+			/// @param src The source array index of the first element in the run.
+			/// @param src_delta The delta used to iterate through the source index.
+			/// @param count The number of elements in the run.
+			/// @return False, without writing anything, if any destination element covers a partial source element or reaches outside of the source array.
+			bool whole(const Point<int32_t,dimensions> &dst, const Point<fixed32_t,dimensions> &src, const Point<fixed32_t,dimensions> &src_delta, int32_t count) const
+			{
+				static constexpr int32_t ONE  = internal::box_span::ONE;
+				static constexpr int32_t MASK = ONE - 1;
+				int32_t size[dimensions];
+				float weight = 1.0f;
+				const src_t *in = m_src;
+				dst_t *out = m_dst;
+				for (uint32_t i = 0; i < dimensions; ++i) {
+					if (src_delta[i].value_bits <= 0 || internal::classify(src_delta[i], size[i]) != internal::ratio::integer || (src[i].value_bits & MASK) != 0) { return false; }
+					const int32_t first = int32_t(src[i]);
+					const int64_t end = int64_t(first) + int64_t(size[i]) * (i == 0 ? count : 1);
+					if (first < 0 || end > m_src_size[i]) { return false; }
+					// The product of the weights box_span gives a whole element, rather than the reciprocal of the volume, which can differ in the last bit.
+					weight *= float(ONE) * (1.0f / float(src_delta[i].value_bits));
+					in += first * m_src_stride[i];
+					out += dst[i] * m_dst_stride[i];
+				}
+				for (int32_t n = 0; n < count; ++n, out += m_dst_stride[0], in += size[0] * m_src_stride[0]) {
+					*out = internal::filtered<dst_t>::from(internal::block_sample(in, m_src_stride, size, weight));
+				}
+				return true;
+			}
+
+		public:
+
+			/// @brief Writes an entire run to the destination array starting at the provided destination and source indices.
+			/// @param dst The destination array index of the first element in the run.
+			/// @param src The source array index of the first element in the run.
+			/// @param src_delta The delta used to iterate through the source index.
+			/// @param count The number of elements in the run.
+			/// @note The covered ranges of the outer axes are computed once per run, and indices are only clamped near the edges of the source array.
+			void operator()(const Point<int32_t,dimensions> &dst, const Point<fixed32_t,dimensions> &src, const Point<fixed32_t,dimensions> &src_delta, int32_t count) const
+			{
+				if (whole(dst, src, src_delta, count)) { return; }
+				internal::box_span span[dimensions];
+				dst_t *out = m_dst;
+				for (uint32_t i = 0; i < dimensions; ++i) {
+					span[i].set(src[i], src_delta[i]);
+					out += dst[i] * m_dst_stride[i];
+				}
+				// Only the elements whose spans stay inside of the source array along all axes skip clamping.
+				int32_t lo = 0, hi = 0;
+				bool inside = true;
+				for (uint32_t i = 1; i < dimensions; ++i) {
+					inside = inside && span[i].first >= 0 && span[i].last < m_src_size[i];
+				}
+				if (inside) {
+					const int32_t d = span[0].b - span[0].a;
+					internal::interior(src[0].value_bits, src_delta[0].value_bits, count, int64_t(m_src_size[0]) * internal::box_span::ONE - d + 1, lo, hi);
+				}
+				fixed32_t s = src[0];
+				for (int32_t n = 0; n < count; ++n, out += m_dst_stride[0]) {
+					*out = internal::filtered<dst_t>::from(n >= lo && n < hi ? internal::box_sample<src_t,dimensions,false>(m_src, m_src_stride, m_src_size, span) : internal::box_sample(m_src, m_src_stride, m_src_size, span));
+					s += src_delta[0];
+					span[0].set(s, src_delta[0]);
+				}
+			}
+		};
+
+		/// @brief For internal use only. Do not use.
+		namespace internal
+		{
+			/// @brief Converts channel values between element types. Integer channels span their entire range, while floating-point channels are in the range [0, 1].
+			/// @tparam type_t The type of the channel.
+			template < typename type_t >
+			struct channel;
+
+			/// @brief Converts 8-bit channel values.
+			template <>
+			struct channel<uint8_t>
+			{
+				/// @brief Returns the value of a fully saturated channel.
+				/// @return The value.
+				static uint8_t one( void ) { return 255; }
+
+				/// @brief Normalizes a channel value.
+				/// @param v The channel value.
+				/// @return The normalized value.
+				static float to_unit(uint8_t v) { return float(v) * (1.0f / 255.0f); }
+
+				/// @brief Converts a normalized value to a channel value, rounding and clamping it to the range of the channel.
+				/// @param v The normalized value.
+				/// @return The channel value.
+				static uint8_t from_unit(float v) { return v <= 0.0f ? 0 : (v >= 1.0f ? 255 : uint8_t(v * 255.0f + 0.5f)); }
+			};
+
+			/// @brief Converts 16-bit channel values.
+			template <>
+			struct channel<uint16_t>
+			{
+				/// @brief Returns the value of a fully saturated channel.
+				/// @return The value.
+				static uint16_t one( void ) { return 65535; }
+
+				/// @brief Normalizes a channel value.
+				/// @param v The channel value.
+				/// @return The normalized value.
+				static float to_unit(uint16_t v) { return float(v) * (1.0f / 65535.0f); }
+
+				/// @brief Converts a normalized value to a channel value, rounding and clamping it to the range of the channel.
+				/// @param v The normalized value.
+				/// @return The channel value.
+				static uint16_t from_unit(float v) { return v <= 0.0f ? 0 : (v >= 1.0f ? 65535 : uint16_t(v * 65535.0f + 0.5f)); }
+			};
+
+			/// @brief Converts floating-point channel values.
+			template <>
+			struct channel<float>
+			{
+				/// @brief Returns the value of a fully saturated channel.
+				/// @return The value.
+				static float one( void ) { return 1.0f; }
+
+				/// @brief Normalizes a channel value.
+				/// @param v The channel value.
+				/// @return The normalized value.
+				static float to_unit(float v) { return v; }
+
+				/// @brief Converts a normalized value to a channel value.
+				/// @param v The normalized value.
+				/// @return The channel value.
+				static float from_unit(float v) { return v; }
+			};
+
+			/// @brief Converts a channel value between element types.
+			/// @tparam dst_t The destination channel type.
+			/// @tparam src_t The source channel type.
+			/// @param v The channel value.
+			/// @return The converted channel value.
+			template < typename dst_t, typename src_t >
+			inline dst_t convert_channel(src_t v)
+			{
+				return is_same<dst_t,src_t>::value ? dst_t(v) : channel<dst_t>::from_unit(channel<src_t>::to_unit(v));
+			}
+		}
+
+		/// @brief A pixel format storing four 8-bit channels in one 32-bit word per pixel, e.g. RGBA8 or BGRA8.
+		/// @tparam r The byte in memory holding the red channel.
+		/// @tparam g The byte in memory holding the green channel.
+		/// @tparam b The byte in memory holding the blue channel.
+		/// @tparam a The byte in memory holding the alpha channel.
+		/// @note Pixel formats contain the element type of the array, the number of elements per pixel, the type of unpacked channel values, and `load`/`store` functions converting a pixel from and to red, green, blue, and alpha channel values.
+		template < uint32_t r, uint32_t g, uint32_t b, uint32_t a >
+		struct packed8888
+		{
+			typedef uint32_t element_t;            // The type of the elements of the array.
+			typedef uint8_t  channel_t;            // The type of the unpacked channel values.
+			static constexpr uint32_t ELEMENTS = 1; // The number of elements per pixel.
+
+			/// @brief Returns the number of bits a channel is shifted by in the 32-bit word.
+			/// @param byte The byte in memory holding the channel.
+			/// @return The number of bits.
+			static constexpr uint32_t shift(uint32_t byte)
+			{
+#if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+				return (3 - byte) * 8;
+#else
+				return byte * 8;
+#endif
+			}
+
+			/// @brief Unpacks a pixel.
+			/// @param p The pixel.
+			/// @param c Receives the red, green, blue, and alpha channel values.
+			static void load(const element_t *p, channel_t (&c)[4])
+			{
+				c[0] = channel_t(*p >> shift(r));
+				c[1] = channel_t(*p >> shift(g));
+				c[2] = channel_t(*p >> shift(b));
+				c[3] = channel_t(*p >> shift(a));
+			}
+
+			/// @brief Packs a pixel.
+			/// @param p Receives the pixel.
+			/// @param c The red, green, blue, and alpha channel values.
+			static void store(element_t *p, const channel_t (&c)[4])
+			{
+				*p = (uint32_t(c[0]) << shift(r)) | (uint32_t(c[1]) << shift(g)) | (uint32_t(c[2]) << shift(b)) | (uint32_t(c[3]) << shift(a));
+			}
+		};
+
+		/// @brief A pixel format storing one element per channel, e.g. RGB8 or RGBA32F.
+		/// @tparam type_t The type of each channel.
+		/// @tparam channels The number of elements per pixel.
+		/// @tparam r The element holding the red channel, or -1 if there is none.
+		/// @tparam g The element holding the green channel, or -1 if there is none.
+		/// @tparam b The element holding the blue channel, or -1 if there is none.
+		/// @tparam a The element holding the alpha channel, or -1 if there is none. Missing alpha channels load as opaque.
+		template < typename type_t, uint32_t channels, int32_t r, int32_t g, int32_t b, int32_t a = -1 >
+		struct interleaved
+		{
+			typedef type_t element_t;                      // The type of the elements of the array.
+			typedef type_t channel_t;                      // The type of the unpacked channel values.
+			static constexpr uint32_t ELEMENTS = channels; // The number of elements per pixel.
+
+			/// @brief Unpacks a pixel.
+			/// @param p The pixel.
+			/// @param c Receives the red, green, blue, and alpha channel values.
+			static void load(const element_t *p, channel_t (&c)[4])
+			{
+				c[0] = r >= 0 ? p[r] : channel_t(0);
+				c[1] = g >= 0 ? p[g] : channel_t(0);
+				c[2] = b >= 0 ? p[b] : channel_t(0);
+				c[3] = a >= 0 ? p[a] : internal::channel<channel_t>::one();
+			}
+
+			/// @brief Packs a pixel.
+			/// @param p Receives the pixel.
+			/// @param c The red, green, blue, and alpha channel values.
+			static void store(element_t *p, const channel_t (&c)[4])
+			{
+				if (r >= 0) { p[r] = c[0]; }
+				if (g >= 0) { p[g] = c[1]; }
+				if (b >= 0) { p[b] = c[2]; }
+				if (a >= 0) { p[a] = c[3]; }
+			}
+		};
+
+		/// @brief A pixel format storing 5 bits of red, 6 bits of green, and 5 bits of blue in one 16-bit word per pixel, with red in the highest bits.
+		struct rgb565
+		{
+			typedef uint16_t element_t;            // The type of the elements of the array.
+			typedef uint8_t  channel_t;            // The type of the unpacked channel values.
+			static constexpr uint32_t ELEMENTS = 1; // The number of elements per pixel.
+
+			/// @brief Unpacks a pixel, expanding each channel to 8 bits.
+			/// @param p The pixel.
+			/// @param c Receives the red, green, blue, and alpha channel values.
+			static void load(const element_t *p, channel_t (&c)[4])
+			{
+				const uint32_t v = *p;
+				const uint32_t r = (v >> 11) & 31, g = (v >> 5) & 63, b = v & 31;
+				c[0] = channel_t((r << 3) | (r >> 2));
+				c[1] = channel_t((g << 2) | (g >> 4));
+				c[2] = channel_t((b << 3) | (b >> 2));
+				c[3] = 255;
+			}
+
+			/// @brief Packs a pixel, rounding each channel. Alpha is discarded.
+			/// @param p Receives the pixel.
+			/// @param c The red, green, blue, and alpha channel values.
+			static void store(element_t *p, const channel_t (&c)[4])
+			{
+				const uint32_t r = (uint32_t(c[0]) * 31 + 127) / 255, g = (uint32_t(c[1]) * 63 + 127) / 255, b = (uint32_t(c[2]) * 31 + 127) / 255;
+				*p = element_t((r << 11) | (g << 5) | b);
+			}
+		};
+
+		typedef packed8888<0,1,2,3>                 rgba8;   // Red, green, blue, and alpha bytes in memory order, packed in a 32-bit word.
+		typedef packed8888<2,1,0,3>                 bgra8;   // Blue, green, red, and alpha bytes in memory order, packed in a 32-bit word.
+		typedef packed8888<1,2,3,0>                 argb8;   // Alpha, red, green, and blue bytes in memory order, packed in a 32-bit word.
+		typedef packed8888<3,2,1,0>                 abgr8;   // Alpha, blue, green, and red bytes in memory order, packed in a 32-bit word.
+		typedef interleaved<uint8_t,3,0,1,2>        rgb8;    // Red, green, and blue bytes.
+		typedef interleaved<uint8_t,3,2,1,0>        bgr8;    // Blue, green, and red bytes.
+		typedef interleaved<uint16_t,4,0,1,2,3>     rgba16;  // Red, green, blue, and alpha 16-bit channels.
+		typedef interleaved<float,4,0,1,2,3>        rgba32f; // Red, green, blue, and alpha floats in the range [0, 1].
+		typedef interleaved<float,3,0,1,2>          rgb32f;  // Red, green, and blue floats in the range [0, 1].
+
+		/// @brief For internal use only. Do not use.
+		namespace internal
+		{
+			/// @brief Converts a pixel between two formats one pixel at a time.
+			/// @tparam dst_format_t The destination pixel format.
+			/// @tparam src_format_t The source pixel format.
+			/// @tparam same Determines if the formats are the same.
+			template < typename dst_format_t, typename src_format_t, bool same = is_same<dst_format_t,src_format_t>::value >
+			struct convert_pixels
+			{
+				static constexpr bool PACKED = false; // True if entire rows can be moved with write_row and converted in place.
+
+				/// @brief Converts a pixel.
+				/// @param dst The destination pixel.
+				/// @param src The source pixel.
+				static void pixel(typename dst_format_t::element_t *dst, const typename src_format_t::element_t *src)
+				{
+					typename src_format_t::channel_t in[4];
+					typename dst_format_t::channel_t out[4];
+					src_format_t::load(src, in);
+					for (uint32_t c = 0; c < 4; ++c) {
+						out[c] = convert_channel<typename dst_format_t::channel_t>(in[c]);
+					}
+					dst_format_t::store(dst, out);
+				}
+			};
+
+			/// @brief Moves pixels of the same format.
+			/// @tparam format_t The pixel format.
+			template < typename format_t >
+			struct convert_pixels<format_t,format_t,true>
+			{
+				static constexpr bool PACKED = format_t::ELEMENTS == 1; // True if entire rows can be moved with write_row and converted in place.
+
+				/// @brief Copies a pixel.
+				/// @param dst The destination pixel.
+				/// @param src The source pixel.
+				static void pixel(typename format_t::element_t *dst, const typename format_t::element_t *src)
+				{
+					for (uint32_t e = 0; e < format_t::ELEMENTS; ++e) {
+						dst[e] = src[e];
+					}
+				}
+
+				/// @brief Converts a row of pixels in place after they have been moved. Does nothing.
+				static void row(typename format_t::element_t*, int32_t) {}
+			};
+
+			/// @brief Swizzles pixels between two formats with 8-bit channels packed in 32-bit words.
+			template < uint32_t dr, uint32_t dg, uint32_t db, uint32_t da, uint32_t sr, uint32_t sg, uint32_t sb, uint32_t sa >
+			struct convert_pixels< packed8888<dr,dg,db,da>, packed8888<sr,sg,sb,sa>, false >
+			{
+				typedef packed8888<dr,dg,db,da> dst_format_t; // The destination pixel format.
+				typedef packed8888<sr,sg,sb,sa> src_format_t; // The source pixel format.
+				static constexpr bool PACKED = true;          // True if entire rows can be moved with write_row and converted in place.
+
+				/// @brief Moves a single channel from its source position to its destination position.
+				/// @param v The source pixel.
+				/// @param d The destination byte of the channel.
+				/// @param s The source byte of the channel.
+				/// @return The channel at its destination position.
+				static uint32_t move(uint32_t v, uint32_t d, uint32_t s)
+				{
+					return ((v >> dst_format_t::shift(s)) & 0xFF) << dst_format_t::shift(d);
+				}
+
+				/// @brief Swizzles a pixel.
+				/// @param v The source pixel.
+				/// @return The destination pixel.
+				static uint32_t swizzle(uint32_t v)
+				{
+					return move(v, dr, sr) | move(v, dg, sg) | move(v, db, sb) | move(v, da, sa);
+				}
+
+				/// @brief Converts a pixel.
+				/// @param dst The destination pixel.
+				/// @param src The source pixel.
+				static void pixel(uint32_t *dst, const uint32_t *src)
+				{
+					*dst = swizzle(*src);
+				}
+
+				/// @brief Swizzles a row of pixels in place after they have been moved. Written so that the compiler can vectorize it.
+				/// @param row The pixels.
+				/// @param count The number of pixels.
+				static void row(uint32_t *row, int32_t count)
+				{
+					for (int32_t i = 0; i < count; ++i) {
+						row[i] = swizzle(row[i]);
+					}
+				}
+			};
+
+			/// @brief Moves or converts a row of pixels with a packed conversion.
+			/// @tparam packed Determines if the conversion is packed.
+			template < bool packed >
+			struct pixel_row
+			{
+				/// @brief Moves or converts a row of tightly packed pixels.
+				/// @return False, since the conversion is not packed.
+				template < typename convert_t, typename dst_element_t, typename src_element_t, typename fixed_t >
+				static bool run(dst_element_t*, const src_element_t*, fixed_t, fixed_t, int32_t)
+				{
+					return false;
+				}
+			};
+
+			/// @brief Moves a row of pixels with write_row, which may use SIMD, and then converts it in place.
+			template <>
+			struct pixel_row<true>
+			{
+				/// @brief Moves and converts a row of tightly packed pixels.
+				/// @tparam convert_t The conversion.
+				/// @tparam dst_element_t The destination element type.
+				/// @tparam src_element_t The source element type.
+				/// @tparam fixed_t The fixed-point type of the source index.
+				/// @param dst The first destination pixel.
+				/// @param src The source row.
+				/// @param src_start The source index of the first pixel.
+				/// @param src_delta The delta used to iterate through the source index.
+				/// @param count The number of pixels.
+				/// @return True.
+				template < typename convert_t, typename dst_element_t, typename src_element_t, typename fixed_t >
+				static bool run(dst_element_t *dst, const src_element_t *src, fixed_t src_start, fixed_t src_delta, int32_t count)
+				{
+					write_row(dst, src, src_start, src_delta, count);
+					convert_t::row(dst, count);
+					return true;
+				}
+			};
+		}
+
+		/// @brief Processor functor that writes whole pixels from one multi-dimensional image to another, sampling the nearest source pixel like write, while converting between pixel formats. Channels are swizzled and converted between element types, e.g. normalizing uint8 to float, as part of the same pass.
+		/// @tparam dst_format_t The destination pixel format, such as rgba8, bgra8, rgb565, rgb8, or rgba32f.
+		/// @tparam src_format_t The source pixel format.
+		/// @tparam dimensions The number of dimensions of the images.
+		/// @note Strides are given in pixels rather than elements. Moves between identical single-element formats, and swizzles between formats with 8-bit channels packed in 32-bit words, move entire rows with the same SIMD kernels as write.
+		template < typename dst_format_t, typename src_format_t, uint32_t dimensions = 1 >
+		class write_pixels
+		{
+		private:
+			typedef typename dst_format_t::element_t                  dst_t;   // The type of the destination elements.
+			typedef typename src_format_t::element_t                  src_t;   // The type of the source elements.
+			typedef internal::convert_pixels<dst_format_t,src_format_t> convert; // The conversion between the formats.
+
+			dst_t                     *m_dst;        // The destination image.
+			const src_t               *m_src;        // The source image.
+			Point<int32_t,dimensions>  m_dst_stride; // The number of destination elements between two adjacent indices on each axis.
+			Point<int32_t,dimensions>  m_src_stride; // The number of source elements between two adjacent indices on each axis.
+
+		public:
+			/// @brief Creates a new write_pixels object for tightly packed 1D images.
+			/// @param dst The destination image.
+			/// @param src The source image.
+			write_pixels(dst_t *dst, const src_t *src) : m_dst(dst), m_src(src)
+			{
+				static_assert(dimensions == 1, "Images with more than one dimension require strides.");
+				m_dst_stride[0] = int32_t(dst_format_t::ELEMENTS);
+				m_src_stride[0] = int32_t(src_format_t::ELEMENTS);
+			}
+
+			/// @brief Creates a new write_pixels object.
+			/// @param dst The destination image.
+			/// @param dst_stride The number of destination pixels between two adjacent indices on each axis. For a tightly packed 2D image this is { 1, width }.
+			/// @param src The source image.
+			/// @param src_stride The number of source pixels between two adjacent indices on each axis. For a tightly packed 2D image this is { 1, width }.
+			write_pixels(dst_t *dst, const Point<int32_t,dimensions> &dst_stride, const src_t *src, const Point<int32_t,dimensions> &src_stride) : m_dst(dst), m_src(src)
+			{
+				for (uint32_t i = 0; i < dimensions; ++i) {
+					m_dst_stride[i] = dst_stride[i] * int32_t(dst_format_t::ELEMENTS);
+					m_src_stride[i] = src_stride[i] * int32_t(src_format_t::ELEMENTS);
+				}
+			}
+
+			/// @brief Writes a pixel to the destination image from the source image using the provided destination and source indices.
+			/// @tparam fixed_t The fixed-point type of the source index.
+			/// @param dst The destination image index.
+			/// @param src The source image index.
+			template < typename fixed_t >
+			void operator()(const Point<int32_t,dimensions> &dst, const Point<fixed_t,dimensions> &src) const
+			{
+				int32_t d = 0, s = 0;
+				for (uint32_t i = 0; i < dimensions; ++i) {
+					d += dst[i] * m_dst_stride[i];
+					s += int32_t(src[i]) * m_src_stride[i];
+				}
+				convert::pixel(m_dst + d, m_src + s);
+			}
+
+			/// @brief Writes an entire run of pixels to the destination image from the source image starting at the provided destination and source indices.
+			/// @tparam fixed_t The fixed-point type of the source index.
+			/// @param dst The destination image index of the first pixel in the run.
+			/// @param src The source image index of the first pixel in the run.
+			/// @param src_delta The delta used to iterate through the source index.
+			/// @param count The number of pixels in the run.
+			template < typename fixed_t >
+			void operator()(const Point<int32_t,dimensions> &dst, const Point<fixed_t,dimensions> &src, const Point<fixed_t,dimensions> &src_delta, int32_t count) const
+			{
+				dst_t       *out = m_dst;
+				const src_t *in  = m_src;
+				for (uint32_t i = 1; i < dimensions; ++i) {
+					out += dst[i] * m_dst_stride[i];
+					in  += int32_t(src[i]) * m_src_stride[i];
+				}
+				if (m_dst_stride[0] == 1 && m_src_stride[0] == 1 && internal::pixel_row<convert::PACKED>::template run<convert>(out + dst[0], in, src[0], src_delta[0], count)) {
+					return;
+				}
+				out += dst[0] * m_dst_stride[0];
+				fixed_t s = src[0];
+				for (int32_t i = 0; i < count; ++i, out += m_dst_stride[0], s += src_delta[0]) {
+					convert::pixel(out, in + int32_t(s) * m_src_stride[0]);
+				}
+			}
+		};
+
+		/// @brief For internal use only. Do not use.
+		namespace internal
+		{
+			/// @brief Applies a processor to a run along the innermost axis, regardless of if the processor processes elements or rows.
+			/// @tparam rows Determines if the processor is handed entire rows of the innermost axis rather than single elements.
+			/// @tparam controls Determines if the processor returns a control value.
+			template < bool rows, bool controls >
+			struct element_run
+			{
+				/// @brief Applies a processor to each element of a run until it skips the row or stops.
+				/// @tparam processor_t The type of the processor function/functor.
+				/// @tparam dimensions The number of dimensions to iterate over.
+				/// @tparam fixed_t The fixed-point type of the source index.
+				/// @param processor The processor.
+				/// @param dst The destination index of the first element in the run.
+				/// @param src The source index of the first element in the run.
+				/// @param src_delta The delta used to iterate through the source index.
+				/// @param count The number of elements in the run.
+				/// @return The control value that ended the run, or control::proceed if the run was completed.
+				/// @note The innermost indices are stepped as scalars and copied into fresh indices for every element. Stepping them inside the indices makes compilers merge each step into the neighbouring index, so that processors deriving offsets from whole indices load them before the merged store has completed.
+				template < typename processor_t, uint32_t dimensions, typename fixed_t >
+				static control run(const processor_t &processor, Point<int32_t,dimensions> dst, Point<fixed_t,dimensions> src, const Point<fixed_t,dimensions> &src_delta, int32_t count)
+				{
+					int32_t x = dst[0];
+					fixed_t u = src[0];
+					for (int32_t i = 0; i < count; ++i, ++x, u += src_delta[0]) {
+						Point<int32_t,dimensions> dst_index = dst;
+						Point<fixed_t,dimensions> src_index = src;
+						dst_index[0] = x;
+						src_index[0] = u;
+						const control c = invoke<controls>::run(processor, dst_index, src_index);
+						if (c != control::proceed) { return c; }
+					}
+					return control::proceed;
+				}
+			};
+
+			/// @brief Applies a row processor to a run along the innermost axis.
+			/// @tparam controls Determines if the processor returns a control value.
+			template < bool controls >
+			struct element_run<true, controls>
+			{
+				/// @brief Applies a row processor to a run.
+				/// @tparam processor_t The type of the processor function/functor.
+				/// @tparam dimensions The number of dimensions to iterate over.
+				/// @tparam fixed_t The fixed-point type of the source index.
+				/// @param processor The processor.
+				/// @param dst The destination index of the first element in the run.
+				/// @param src The source index of the first element in the run.
+				/// @param src_delta The delta used to iterate through the source index.
+				/// @param count The number of elements in the run.
+				/// @return The control value returned by the processor, or control::proceed.
+				template < typename processor_t, uint32_t dimensions, typename fixed_t >
+				static control run(const processor_t &processor, const Point<int32_t,dimensions> &dst, const Point<fixed_t,dimensions> &src, const Point<fixed_t,dimensions> &src_delta, int32_t count)
+				{
+					return invoke<controls>::run(processor, dst, src, src_delta, count);
+				}
+			};
+		}
+
+		/// @brief Processor functor that drives a processor at a lower resolution than the traversal, such as the chroma planes of YUV420 images. Both the destination and source indices are divided by a per-axis factor, and the processor is only called at destination indices that are multiples of the factors, so that every subsampled destination element is visited exactly once.
+		/// @tparam processor_t The type of the processor driven at the lower resolution.
+		/// @tparam dimensions The number of dimensions of the space to iterate over.
+		/// @note The source delta is unchanged, since one subsampled step spans as many full resolution source elements as it spans full resolution destination elements. Destination areas should start at multiples of the factors, or the first partial subsampled element along an axis is skipped. Returns the control values of processors returning them, so that they can skip the rest of a subsampled run or stop the traversal.
+		template < typename processor_t, uint32_t dimensions >
+		class subsampled
+		{
+		private:
+			processor_t               m_processor; // The processor driven at the lower resolution.
+			Point<int32_t,dimensions> m_factor;    // The subsampling factor along each axis.
+
+		public:
+			/// @brief Creates a new subsampled object.
+			/// @param processor The processor driven at the lower resolution.
+			/// @param factor The subsampling factor along each axis, e.g. { 2, 2 } for the chroma planes of YUV420 images. Must be positive.
+			subsampled(const processor_t &processor, const Point<int32_t,dimensions> &factor) : m_processor(processor), m_factor(factor) {}
+
+			/// @brief Drives the processor over the subsampled elements of a run.
+			/// @tparam fixed_t The fixed-point type of the source index.
+			/// @param dst The destination index of the first element in the run.
+			/// @param src The source index of the first element in the run.
+			/// @param src_delta The delta used to iterate through the source index.
+			/// @param count The number of elements in the run.
+			/// @return The control value of the processor if it returns one.
+			template < typename fixed_t, typename result_t = typename internal::control_type<internal::returns_control<processor_t,dimensions,fixed_t>::value>::type >
+			result_t operator()(const Point<int32_t,dimensions> &dst, const Point<fixed_t,dimensions> &src, const Point<fixed_t,dimensions> &src_delta, int32_t count) const
+			{
+				Point<int32_t,dimensions> sub_dst;
+				Point<fixed_t,dimensions> sub_src;
+				for (uint32_t i = 1; i < dimensions; ++i) {
+					sub_dst[i] = internal::floor_div(dst[i], m_factor[i]);
+					if (sub_dst[i] * m_factor[i] != dst[i]) { return result_t(); }
+					sub_src[i].value_bits = internal::floor_div(src[i].value_bits, typename fixed_t::int_t(m_factor[i]));
+				}
+				const int32_t first = internal::floor_div(dst[0] + m_factor[0] - 1, m_factor[0]); // The first subsampled element starting in the run.
+				const int32_t skip  = first * m_factor[0] - dst[0];
+				if (skip >= count) { return result_t(); }
+				sub_dst[0] = first;
+				sub_src[0].value_bits = internal::floor_div(typename fixed_t::int_t(src[0].value_bits + src_delta[0].value_bits * skip), typename fixed_t::int_t(m_factor[0]));
+				const control c = internal::element_run<internal::is_row_processor<processor_t,dimensions,fixed_t>::value,internal::returns_control<processor_t,dimensions,fixed_t>::value>::run(m_processor, sub_dst, sub_src, src_delta, (count - skip + m_factor[0] - 1) / m_factor[0]);
+				return static_cast<result_t>(c);
+			}
+
+			/// @brief Tells the processor that scaling is done.
+			void finish( void ) const { internal::finish(m_processor); }
+		};
+
+		/// @brief Processor functor that drives several processors, such as one per plane of a planar image, from a single traversal, so that source coordinates and loop overhead are computed once for all of them.
+		/// @tparam processors_t The types of the processors.
+		/// @note Every processor is handed entire runs if it is a row processor, and is otherwise called once per element of each run. Processors are called in order for each run. If any processor returns control values, the combined processor does too: a processor skipping the rest of a run only skips its own run, while a processor stopping stops the traversal once all processors are done with the current run.
+		template < typename... processors_t >
+		class planar;
+
+		/// @brief The end of a list of processors driven by planar.
+		template <>
+		class planar<>
+		{
+		public:
+			/// @brief Does nothing.
+			template < uint32_t dimensions, typename fixed_t >
+			void operator()(const Point<int32_t,dimensions>&, const Point<fixed_t,dimensions>&, const Point<fixed_t,dimensions>&, int32_t) const {}
+
+			/// @brief Does nothing.
+			void finish( void ) const {}
+		};
+
+		/// @brief Processor functor that drives several processors from a single traversal.
+		/// @tparam first_t The type of the first processor.
+		/// @tparam rest_t The types of the remaining processors.
+		template < typename first_t, typename... rest_t >
+		class planar<first_t, rest_t...>
+		{
+		private:
+			first_t           m_first; // The first processor.
+			planar<rest_t...> m_rest;  // The remaining processors.
+
+		public:
+			/// @brief Creates a new planar object.
+			/// @param first The first processor.
+			/// @param rest The remaining processors.
+			explicit planar(const first_t &first, const rest_t&... rest) : m_first(first), m_rest(rest...) {}
+
+			/// @brief Drives all processors over a run.
+			/// @tparam dimensions The number of dimensions to iterate over.
+			/// @tparam fixed_t The fixed-point type of the source index.
+			/// @param dst The destination index of the first element in the run.
+			/// @param src The source index of the first element in the run.
+			/// @param src_delta The delta used to iterate through the source index.
+			/// @param count The number of elements in the run.
+			/// @return control::stop if any processor stopped the traversal, if any processor returns control values.
+			template < uint32_t dimensions, typename fixed_t, typename result_t = typename internal::control_type<internal::returns_control<first_t,dimensions,fixed_t>::value || internal::returns_control<planar<rest_t...>,dimensions,fixed_t>::value>::type >
+			result_t operator()(const Point<int32_t,dimensions> &dst, const Point<fixed_t,dimensions> &src, const Point<fixed_t,dimensions> &src_delta, int32_t count) const
+			{
+				const control first = internal::element_run<internal::is_row_processor<first_t,dimensions,fixed_t>::value,internal::returns_control<first_t,dimensions,fixed_t>::value>::run(m_first, dst, src, src_delta, count);
+				const control rest  = internal::element_run<true,internal::returns_control<planar<rest_t...>,dimensions,fixed_t>::value>::run(m_rest, dst, src, src_delta, count);
+				return static_cast<result_t>(first == control::stop || rest == control::stop ? control::stop : control::proceed);
+			}
+
+			/// @brief Tells all processors that scaling is done.
+			void finish( void ) const
+			{
+				internal::finish(m_first);
+				m_rest.finish();
+			}
+		};
+
+		/// @brief Creates a processor driving a processor at a lower resolution than the traversal.
+		/// @tparam processor_t The type of the processor.
+		/// @tparam dimensions The number of dimensions of the space to iterate over.
+		/// @param processor The processor.
+		/// @param factor The subsampling factor along each axis.
+		/// @return The subsampled processor.
+		template < typename processor_t, uint32_t dimensions >
+		inline subsampled<processor_t,dimensions> subsample(const processor_t &processor, const Point<int32_t,dimensions> &factor)
+		{
+			return subsampled<processor_t,dimensions>(processor, factor);
+		}
+
+		/// @brief Creates a processor driving several processors from a single traversal.
+		/// @tparam processors_t The types of the processors.
+		/// @param processors The processors.
+		/// @return The combined processor.
+		template < typename... processors_t >
+		inline planar<processors_t...> planes(const processors_t&... processors)
+		{
+			return planar<processors_t...>(processors...);
+		}
+
+		/// @brief A filter that samples the source element nearest to each destination element, like write.
+		struct nearest_filter
+		{
+			typedef internal::nearest_span span; // The source elements contributing to a destination element along one axis.
+		};
+
+		/// @brief A filter for scale_separable that linearly interpolates between the two source elements nearest to the center of each destination element.
+		/// @note Filters contain a span type with `set(src_index, src_delta)`, `first`, `last`, `weight(j)`, and `taps(src_delta)` members describing which source elements along an axis contribute to a destination element, and by how much.
+		struct linear_filter
+		{
+			typedef internal::linear_span span; // The source elements contributing to a destination element along one axis.
+		};
+
+		/// @brief A filter for scale_separable that averages all source elements covered by each destination element, weighted by coverage.
+		struct box_filter
+		{
+			typedef internal::box_span span; // The source elements contributing to a destination element along one axis.
+		};
+
+		/// @brief The arrays and intermediate row cache used by scale_separable to filter a 2D source array into a 2D destination array one axis at a time.
+		/// @tparam filter_t The filter, such as linear_filter or box_filter.
+		/// @tparam dst_t The type of the destination array.
+		/// @tparam src_t The type of the source array.
+		/// @note Source rows are first filtered along axis 0 into a ring buffer of intermediate rows, which are then filtered along axis 1 into the destination. Each source row is only filtered along axis 0 once, even when several destination rows use it. The ring buffer is provided by the caller.
+		template < typename filter_t, typename dst_t, typename src_t >
+		class separable
+		{
+		private:
+			dst_t            *m_dst;        // The destination array.
+			const src_t      *m_src;        // The source array.
+			Point<int32_t,2>  m_dst_stride; // The number of destination elements between two adjacent indices on each axis.
+			Point<int32_t,2>  m_src_stride; // The number of source elements between two adjacent indices on each axis.
+			Point<int32_t,2>  m_src_size;   // The number of source elements along each axis.
+			float            *m_ring;       // The intermediate rows.
+			int32_t           m_ring_width; // The number of elements in each intermediate row.
+			int32_t           m_ring_rows;  // The number of intermediate rows.
+
+			static constexpr int32_t BLOCK = 64; // The number of destination elements summed at a time along axis 1.
+
+		private:
+			/// @brief Returns the intermediate row caching a given source row.
+			/// @param j The source row.
+			/// @return The intermediate row.
+			float *row(int32_t j) const
+			{
+				return m_ring + ((j % m_ring_rows) + m_ring_rows) % m_ring_rows * m_ring_width;
+			}
+
+			/// @brief Filters a source row along axis 0 into the intermediate row caching it.
+			/// @param j The source row.
+			/// @param width The number of elements in the row.
+			/// @param src_start The source index along axis 0 at the start of the row.
+			/// @param src_delta The delta used to iterate through the source index along axis 0.
+			void filter_row(int32_t j, int32_t width, fixed32_t src_start, fixed32_t src_delta) const
+			{
+				float       *out = row(j);
+				const src_t *in  = m_src + internal::clamp_index(j, m_src_size[1]) * m_src_stride[1];
+				typename filter_t::span span;
+				for (int32_t x = 0; x < width; ++x, src_start += src_delta) {
+					span.set(src_start, src_delta);
+					float sum = 0.0f;
+					if (span.first >= 0 && span.last < m_src_size[0]) { // Elements away from the edges need no clamping.
+						for (int32_t k = span.first; k <= span.last; ++k) {
+							sum += span.weight(k) * float(in[k * m_src_stride[0]]);
+						}
+					} else {
+						for (int32_t k = span.first; k <= span.last; ++k) {
+							sum += span.weight(k) * float(in[internal::clamp_index(k, m_src_size[0]) * m_src_stride[0]]);
+						}
+					}
+					out[x] = sum;
+				}
+			}
+
+		public:
+			/// @brief Creates a new separable object.
+			/// @param dst The destination array.
+			/// @param dst_stride The number of destination elements between two adjacent indices on each axis.
+			/// @param src The source array.
+			/// @param src_stride The number of source elements between two adjacent indices on each axis.
+			/// @param src_size The number of source elements along each axis.
+			/// @param ring The intermediate rows, containing `ring_width * ring_rows` elements.
+			/// @param ring_width The number of elements in each intermediate row. Must be at least the width of the destination area.
+			/// @param ring_rows The number of intermediate rows. Must be at least `rows(dst_area, src_area)`.
+			separable(dst_t *dst, const Point<int32_t,2> &dst_stride, const src_t *src, const Point<int32_t,2> &src_stride, const Point<int32_t,2> &src_size, float *ring, int32_t ring_width, int32_t ring_rows) : m_dst(dst), m_src(src), m_dst_stride(dst_stride), m_src_stride(src_stride), m_src_size(src_size), m_ring(ring), m_ring_width(ring_width), m_ring_rows(ring_rows) {}
+
+			/// @brief Returns the number of intermediate rows needed to scale a source area across a destination area.
+			/// @param dst_area The destination area.
+			/// @param src_area The source area.
+			/// @return The number of intermediate rows.
+			static int32_t rows(const Area<int32_t,2> &dst_area, const Area<fixed32_t,2> &src_area)
+			{
+				const int32_t dst_width = dst_area.b[1] - dst_area.a[1];
+				fixed32_t src_delta;
+				src_delta.value_bits = dst_width != 0 ? (src_area.b[1].value_bits - src_area.a[1].value_bits) / dst_width : 0;
+				return filter_t::span::taps(src_delta);
+			}
+
+			/// @brief Returns the number of elements in each intermediate row.
+			/// @return The number of elements.
+			int32_t ring_width( void ) const { return m_ring_width; }
+
+			/// @brief Returns the number of intermediate rows.
+			/// @return The number of rows.
+			int32_t ring_rows( void ) const { return m_ring_rows; }
+
+			/// @brief Filters a clipped destination area. Called by scale_separable.
+			/// @param dst_area The clipped destination area. All axes are in order.
+			/// @param src_start The source index at the start of the clipped destination area.
+			/// @param src_delta The delta used to iterate through the source index.
+			void operator()(const Area<int32_t,2> &dst_area, const Point<fixed32_t,2> &src_start, const Point<fixed32_t,2> &src_delta) const
+			{
+				const int32_t width = dst_area.b[0] - dst_area.a[0];
+				const bool    down  = src_delta[1].value_bits < 0;
+				int32_t lo = 0, n = 0; // The source rows currently cached are [lo, lo + n).
+				typename filter_t::span span;
+				fixed32_t src_y = src_start[1];
+				for (int32_t y = dst_area.a[1]; y < dst_area.b[1]; ++y, src_y += src_delta[1]) {
+					span.set(src_y, src_delta[1]);
+					for (int32_t k = 0; k <= span.last - span.first; ++k) {
+						const int32_t j = down ? span.last - k : span.first + k;
+						if (j >= lo && j < lo + n) { continue; }
+						if (n > 0 && j == lo + n) {
+							if (n == m_ring_rows) { ++lo; } else { ++n; }
+						} else if (n > 0 && j == lo - 1) {
+							--lo;
+							if (n < m_ring_rows) { ++n; }
+						} else {
+							lo = j;
+							n = 1;
+						}
+						filter_row(j, width, src_start[0], src_delta[0]);
+					}
+					// Sums the intermediate rows a block at a time, so that each row is found once per block and the sums vectorize.
+					dst_t *out = m_dst + y * m_dst_stride[1] + dst_area.a[0] * m_dst_stride[0];
+					for (int32_t x0 = 0; x0 < width; x0 += BLOCK) {
+						const int32_t count = width - x0 < BLOCK ? width - x0 : int32_t(BLOCK);
+						float sum[BLOCK];
+						for (int32_t x = 0; x < count; ++x) { sum[x] = 0.0f; }
+						for (int32_t j = span.first; j <= span.last; ++j) {
+							const float  w  = span.weight(j);
+							const float *in = row(j) + x0;
+							for (int32_t x = 0; x < count; ++x) { sum[x] += w * in[x]; }
+						}
+						for (int32_t x = 0; x < count; ++x, out += m_dst_stride[0]) {
+							*out = internal::filtered<dst_t>::from(sum[x]);
+						}
+					}
+				}
+			}
+		};
+
+		/// @brief The default traversal policy that iterates over the destination area in row-major order, i.e. axis 0 changes the fastest and the last axis the slowest.
+		class row_major
+		{
+		public:
+			/// @brief Iterates over a clipped destination area.
+			/// @tparam processor_t The type of the processor function/functor.
+			/// @tparam dimensions The number of dimensions to iterate over.
+			/// @tparam fixed_t The fixed-point type of the source index.
+			/// @param dst_area The clipped destination area. All axes are in order.
+			/// @param src_start The source index at the start of the clipped destination area.
+			/// @param src_delta The delta used to iterate through the source index.
+			/// @param processor The processor function/functor to apply.
+			/// @return False if the processor stopped the traversal by returning control::stop.
+			template < typename processor_t, uint32_t dimensions, typename fixed_t >
+			bool operator()(const Area<int32_t,dimensions> &dst_area, const Point<fixed_t,dimensions> &src_start, const Point<fixed_t,dimensions> &src_delta, const processor_t &processor) const
+			{
+				return internal::row_major_iterator<internal::returns_control<processor_t,dimensions,fixed_t>::value>::run(dst_area, src_start, src_delta, processor);
+			}
+		};
+
+		/// @brief For internal use only. Do not use.
+		namespace internal
+		{
+			/// @brief Updates the coordinates of a Morton code on every axis, unrolled at compile-time so that the coordinates stay in registers.
+			/// @tparam index The current axis.
+			/// @tparam dimensions The number of dimensions of the grid.
+			template < uint32_t index, uint32_t dimensions >
+			struct morton_axes
+			{
+				/// @brief Applies a carry into a bit of the code to the coordinates.
+				/// @param x The coordinates within the grid.
+				/// @param keep The coordinate bits kept on each axis.
+				/// @param grow The coordinate bit set on each axis.
+				/// @param extent The extent of the grid along each axis.
+				/// @return True if the coordinates are inside of the grid.
+				static bool carry(Point<int32_t,dimensions> &x, const int32_t *keep, const int32_t *grow, const Point<int32_t,dimensions> &extent)
+				{
+					x[index] = (x[index] & keep[index]) | grow[index];
+					return morton_axes<index-1,dimensions>::carry(x, keep, grow, extent) & (x[index] < extent[index]);
+				}
+			};
+
+			/// @brief Updates the coordinates of a Morton code on the innermost axis.
+			/// @tparam dimensions The number of dimensions of the grid.
+			template < uint32_t dimensions >
+			struct morton_axes<0, dimensions>
+			{
+				/// @brief Applies a carry into a bit of the code to the coordinates.
+				/// @param x The coordinates within the grid.
+				/// @param keep The coordinate bits kept on each axis.
+				/// @param grow The coordinate bit set on each axis.
+				/// @param extent The extent of the grid along each axis.
+				/// @return True if the coordinates are inside of the grid.
+				static bool carry(Point<int32_t,dimensions> &x, const int32_t *keep, const int32_t *grow, const Point<int32_t,dimensions> &extent)
+				{
+					x[0] = (x[0] & keep[0]) | grow[0];
+					return x[0] < extent[0];
+				}
+			};
+		}
+
+		/// @brief A traversal policy that divides the destination area into tiles and iterates over one tile at a time. Keeps source accesses local when the source is heavily shrunk or traversed against its memory layout.
+		/// @note The processor is called with the same destination and source indices as with row_major, only in a different order. Inside each tile elements are always visited in row-major order, so row processors receive entire rows of the tile.
+		class tiled
+		{
+		private:
+			static constexpr int32_t  MIN_WIDTH = 64; // The smallest length of tiles along axis 0 in Morton order, so that every run spans at least a cache line of bytes.
+			static constexpr uint32_t MAX_BITS  = 63; // The largest number of bits in the Morton code of a tile.
+
+			int32_t m_size;    // The length of each tile along every axis.
+			bool    m_z_order; // Determines if tiles are visited in Morton order rather than row-major order.
+
+		private:
+			/// @brief Iterates over a single tile in row-major order.
+			/// @tparam processor_t The type of the processor function/functor.
+			/// @tparam dimensions The number of dimensions to iterate over.
+			/// @tparam fixed_t The fixed-point type of the source index.
+			/// @param dst_area The clipped destination area. All axes are in order.
+			/// @param src_start The source index at the start of the clipped destination area.
+			/// @param src_delta The delta used to iterate through the source index.
+			/// @param start The destination index at the start of the tile.
+			/// @param size The length of each tile along each axis.
+			/// @param processor The processor function/functor to apply.
+			/// @return False if the processor stopped the traversal.
+			template < typename processor_t, uint32_t dimensions, typename fixed_t >
+			static bool visit(const Area<int32_t,dimensions> &dst_area, const Point<fixed_t,dimensions> &src_start, const Point<fixed_t,dimensions> &src_delta, const Point<int32_t,dimensions> &start, const Point<int32_t,dimensions> &size, const processor_t &processor)
+			{
+				Area<int32_t,dimensions>  tile;
+				Point<fixed_t,dimensions> tile_start;
+				tile.a = start;
+				for (uint32_t i = 0; i < dimensions; ++i) {
+					tile.b[i] = int32_t(internal::min(int64_t(start[i]) + size[i], int64_t(dst_area.b[i])));
+					tile_start[i] = internal::advance(src_start[i], src_delta[i], int64_t(start[i]) - dst_area.a[i]);
+				}
+				return row_major{}(tile, tile_start, src_delta, processor);
+			}
+
+			/// @brief Iterates over the tiles of a clipped destination area in Morton order. Each axis gets as many bits of the code as its number of tiles needs, interleaved from the lowest bit for as long as the axis has bits left. The code is stepped one increment at a time, which clears the bits below the lowest zero bit and sets it, so only the axis owning that bit grows while the others have their lower bits cleared. Whenever the growing axis leaves the area, every code up to the next carry past that bit lies outside of the area as well and is skipped.
+			/// @tparam processor_t The type of the processor function/functor.
+			/// @tparam dimensions The number of dimensions to iterate over.
+			/// @tparam fixed_t The fixed-point type of the source index.
+			/// @param dst_area The clipped destination area. All axes are in order.
+			/// @param src_start The source index at the start of the clipped destination area.
+			/// @param src_delta The delta used to iterate through the source index.
+			/// @param size The length of each tile along each axis.
+			/// @param count The number of tiles along each axis.
+			/// @param bits The number of bits of the code owned by each axis.
+			/// @param total The number of bits of the code.
+			/// @param processor The processor function/functor to apply.
+			/// @return False if the processor stopped the traversal.
+			template < typename processor_t, uint32_t dimensions, typename fixed_t >
+			static bool z_order(const Area<int32_t,dimensions> &dst_area, const Point<fixed_t,dimensions> &src_start, const Point<fixed_t,dimensions> &src_delta, const Point<int32_t,dimensions> &size, const Point<int32_t,dimensions> &count, const uint32_t (&bits)[dimensions], uint32_t total, const processor_t &processor)
+			{
+				// Indexed by the bit of the code carried into and the axis, so that every axis is updated without selecting the owning axis at run-time.
+				int32_t  keep[MAX_BITS][dimensions]; // The coordinate bits kept on each axis.
+				int32_t  grow[MAX_BITS][dimensions]; // The coordinate bit set on each axis, which is zero on all but the owning axis.
+				uint32_t used[dimensions] = { 0 };
+				for (uint32_t p = 0; p < total; ) {
+					for (uint32_t i = 0; i < dimensions; ++i) {
+						if (used[i] < bits[i]) {
+							for (uint32_t j = 0; j < dimensions; ++j) {
+								keep[p][j] = ~((int32_t(1) << used[j]) - 1);
+								grow[p][j] = 0;
+							}
+							grow[p][i] = int32_t(1) << used[i]++;
+							++p;
+						}
+					}
+				}
+				Point<int32_t,dimensions> x;
+				Point<int32_t,dimensions> start;
+				for (uint32_t i = 0; i < dimensions; ++i) {
+					x[i] = 0;
+				}
+				const uint64_t end = uint64_t(1) << total;
+				uint64_t code = 0;
+				for (;;) {
+					for (uint32_t i = 0; i < dimensions; ++i) {
+						start[i] = int32_t(dst_area.a[i] + int64_t(x[i]) * size[i]);
+					}
+					if (!visit(dst_area, src_start, src_delta, start, size, processor)) { return false; }
+					bool inside;
+					do {
+						if (++code >= end) { return true; }
+						// The increment carried into the lowest set bit and cleared all bits below it.
+						const uint32_t t = internal::lowest_bit(code);
+						inside = internal::morton_axes<dimensions-1,dimensions>::carry(x, keep[t], grow[t], count);
+						// Only the owning axis grew, and every code up to the next carry past t has it at least as large.
+						if (!inside) { code += (uint64_t(1) << t) - 1; }
+					} while (!inside);
+				}
+			}
+
+		public:
+			/// @brief Creates a new tiled traversal policy.
+			/// @param size The length of each tile along every axis.
+			/// @param z_order Determines if tiles are visited in Morton (Z) order rather than row-major order. Tiles are then at least 64 elements long along axis 0, so that every run spans at least a cache line. 1D areas and grids of tiles too large for a 64-bit code are visited in row-major order.
+			explicit tiled(int32_t size = 64, bool z_order = false) : m_size(size > 0 ? size : 1), m_z_order(z_order) {}
+
+			/// @brief Iterates over a clipped destination area one tile at a time.
+			/// @tparam processor_t The type of the processor function/functor.
+			/// @tparam dimensions The number of dimensions to iterate over.
+			/// @tparam fixed_t The fixed-point type of the source index.
+			/// @param dst_area The clipped destination area. All axes are in order.
+			/// @param src_start The source index at the start of the clipped destination area.
+			/// @param src_delta The delta used to iterate through the source index.
+			/// @param processor The processor function/functor to apply.
+			/// @return False if the processor stopped the traversal.
+			template < typename processor_t, uint32_t dimensions, typename fixed_t >
+			bool operator()(const Area<int32_t,dimensions> &dst_area, const Point<fixed_t,dimensions> &src_start, const Point<fixed_t,dimensions> &src_delta, const processor_t &processor) const
+			{
+				Point<int32_t,dimensions> size;
+				for (uint32_t i = 0; i < dimensions; ++i) {
+					size[i] = m_size;
+				}
+				if (m_z_order) {
+					size[0] = internal::max(m_size, MIN_WIDTH);
+				}
+				// Morton order over a single axis is row order.
+				if (m_z_order && dimensions > 1) {
+					Point<int32_t,dimensions> count;
+					uint32_t bits[dimensions];
+					uint32_t total = 0;
+					for (uint32_t i = 0; i < dimensions; ++i) {
+						count[i] = int32_t((int64_t(dst_area.b[i]) - dst_area.a[i] + size[i] - 1) / size[i]);
+						bits[i] = 0;
+						while ((int64_t(1) << bits[i]) < count[i]) { ++bits[i]; }
+						total += bits[i];
+					}
+					if (total <= MAX_BITS) {
+						return z_order(dst_area, src_start, src_delta, size, count, bits, total, processor);
+					}
+				}
+				Point<int32_t,dimensions> start = dst_area.a;
+				for (;;) {
+					if (!visit(dst_area, src_start, src_delta, start, size, processor)) { return false; }
+					uint32_t i = 0;
+					for (; i < dimensions; ++i) {
+						if (int64_t(start[i]) + size[i] < dst_area.b[i]) {
+							start[i] += size[i];
+							break;
+						}
+						start[i] = dst_area.a[i];
+					}
+					if (i == dimensions) { break; }
+				}
+				return true;
+			}
+		};
+
+		/// @brief A traversal policy for sources that are read in strips, such as rasters too large to fit in memory. Visits the destination area in row-major order, one slice along the outermost axis at a time, and before each slice reports the range of source slices along the outermost axis that the slice reads to a caller-supplied reader, so the reader can page in exactly those slices and drop the others.
+		/// @tparam reader_t The type of the reader. Called as `reader(first, last)` with the first and last source slice, inclusive, along the outermost axis needed by the next destination slice.
+		/// @tparam filter_t The filter used by the processor, determining which source slices contribute to a destination slice, such as nearest_filter for write, linear_filter for write_linear, or box_filter for write_box.
+		/// @note The processor is called with the same destination and source indices as with row_major. The reader is only called when the range changes. The range can extend past the ends of the source area for filters reading neighbouring elements, and progresses towards lower slices when the outermost axis is reversed. The spans of the filters are defined for fixed32_t source indices only.
+		template < typename reader_t, typename filter_t = nearest_filter >
+		class streamed
+		{
+		private:
+			const reader_t &m_reader; // The reader. Kept by reference, since readers such as mapped_rows keep track of the slices in use across calls.
+
+		public:
+			/// @brief Creates a new streamed traversal policy.
+			/// @param reader The reader paging in source slices. Must outlive the policy.
+			explicit streamed(const reader_t &reader) : m_reader(reader) {}
+
+			/// @brief Prevents creating a policy referring to a temporary reader.
+			streamed(const reader_t&&) = delete;
+
+			/// @brief Iterates over a clipped destination area one slice along the outermost axis at a time.
+			/// @tparam processor_t The type of the processor function/functor.
+			/// @tparam dimensions The number of dimensions to iterate over.
+			/// @tparam fixed_t The fixed-point type of the source index.
+			/// @param dst_area The clipped destination area. All axes are in order.
+			/// @param src_start The source index at the start of the clipped destination area.
+			/// @param src_delta The delta used to iterate through the source index.
+			/// @param processor The processor function/functor to apply.
+			/// @return False if the processor stopped the traversal.
+			template < typename processor_t, uint32_t dimensions, typename fixed_t >
+			bool operator()(const Area<int32_t,dimensions> &dst_area, const Point<fixed_t,dimensions> &src_start, const Point<fixed_t,dimensions> &src_delta, const processor_t &processor) const
+			{
+				static_assert(internal::is_same<fixed_t,fixed32_t>::value, "The spans of the filters used by streamed require fixed32_t source indices.");
+				static constexpr uint32_t AXIS = dimensions - 1;
+				Area<int32_t,dimensions>  slice = dst_area;
+				Point<fixed_t,dimensions> slice_start = src_start;
+				int32_t first = 0, last = -1;
+				for (slice.a[AXIS] = dst_area.a[AXIS]; slice.a[AXIS] < dst_area.b[AXIS]; ++slice.a[AXIS]) {
+					slice.b[AXIS] = slice.a[AXIS] + 1;
+					typename filter_t::span span;
+					span.set(slice_start[AXIS], src_delta[AXIS]);
+					if (span.first != first || span.last != last) {
+						first = span.first;
+						last = span.last;
+						m_reader(first, last);
+					}
+					if (!row_major()(slice, slice_start, src_delta, processor)) { return false; }
+					slice_start[AXIS] += src_delta[AXIS];
+				}
+				return true;
+			}
+		};
+
+		/// @brief A coarse bitmap marking which cells of a destination are occupied, used by the sparse traversal policy to skip empty parts of the destination. The destination is divided into square cells starting at an origin, with one bit per cell. Bits are stored in row-major order, cells along axis 0 are packed into 64-bit words with the lowest bit first, and every row of cells along axis 0 starts at a new word.
+		/// @tparam dimensions The number of dimensions of the destination.
+		template < uint32_t dimensions >
+		struct Occupancy
+		{
+			const uint64_t            *bits;   // The bits of the cells.
+			Point<int32_t,dimensions>  origin; // The destination index of the start of the first cell.
+			Point<int32_t,dimensions>  cells;  // The number of cells along each axis.
+			int32_t                    size;   // The length of each cell along every axis.
+
+			/// @brief Returns the number of words in each row of cells along axis 0.
+			/// @return The number of words.
+			int32_t row_words( void ) const { return (cells[0] + 63) / 64; }
+
+			/// @brief Returns the number of words needed to store the bits of all cells.
+			/// @return The number of words.
+			uint64_t words( void ) const
+			{
+				uint64_t n = uint64_t(row_words());
+				for (uint32_t i = 1; i < dimensions; ++i) {
+					n *= uint64_t(cells[i]);
+				}
+				return n;
+			}
+
+			/// @brief Returns the index of the first word of a row of cells along axis 0.
+			/// @param cell The cell. The index along axis 0 is ignored. Must be inside of the bitmap.
+			/// @return The index of the word.
+			uint64_t row(const Point<int32_t,dimensions> &cell) const
+			{
+				uint64_t r = 0;
+				for (uint32_t i = dimensions - 1; i > 0; --i) {
+					r = r * uint64_t(cells[i]) + uint64_t(cell[i]);
+				}
+				return r * uint64_t(row_words());
+			}
+		};
+
+		/// @brief A traversal policy that only visits the parts of the destination area inside of occupied cells of an occupancy bitmap, skipping empty runs along the innermost axis entirely. Processing is proportional to the number of occupied cells rather than the size of the destination area.
+		/// @tparam dimensions The number of dimensions of the destination.
+		/// @note The processor is called with the same destination and source indices as with row_major, except that indices in unoccupied cells, or outside of the bitmap, are skipped. Row processors receive one run per span of occupied cells.
+		/// @sa Occupancy
+		template < uint32_t dimensions >
+		class sparse
+		{
+		private:
+			Occupancy<dimensions> m_occupancy; // The occupancy bitmap. Copied, so only the bits must outlive the policy.
+
+		private:
+			/// @brief Finds the first bit with a given value in a row of cells.
+			/// @param row The words of the row.
+			/// @param p The first bit to consider.
+			/// @param end The bit to stop at.
+			/// @param set The value to find.
+			/// @return The index of the bit, or end if there is none.
+			static int32_t find(const uint64_t *row, int32_t p, int32_t end, bool set)
+			{
+				while (p < end) {
+					const uint64_t word = (set ? row[p >> 6] : ~row[p >> 6]) >> (p & 63);
+					if (word != 0) {
+						p += int32_t(internal::lowest_bit(word));
+						return p < end ? p : end;
+					}
+					p = (p | 63) + 1;
+				}
+				return end;
+			}
+
+		public:
+			/// @brief Creates a new sparse traversal policy.
+			/// @param occupancy The occupancy bitmap of the destination. The bits are referenced, not copied.
+			explicit sparse(const Occupancy<dimensions> &occupancy) : m_occupancy(occupancy) {}
+
+			/// @brief Iterates over the occupied parts of a clipped destination area.
+			/// @tparam processor_t The type of the processor function/functor.
+			/// @tparam fixed_t The fixed-point type of the source index.
+			/// @param dst_area The clipped destination area. All axes are in order.
+			/// @param src_start The source index at the start of the clipped destination area.
+			/// @param src_delta The delta used to iterate through the source index.
+			/// @param processor The processor function/functor to apply.
+			/// @return False if the processor stopped the traversal.
+			template < typename processor_t, typename fixed_t >
+			bool operator()(const Area<int32_t,dimensions> &dst_area, const Point<fixed_t,dimensions> &src_start, const Point<fixed_t,dimensions> &src_delta, const processor_t &processor) const
+			{
+				const Occupancy<dimensions> &o = m_occupancy;
+				if (o.size <= 0) { return true; }
+				Area<int32_t,dimensions> run = dst_area;
+				Point<fixed_t,dimensions> run_start = src_start;
+				Point<int32_t,dimensions> cell;
+				for (uint32_t i = 1; i < dimensions; ++i) {
+					run.b[i] = run.a[i] + 1;
+				}
+				const int32_t first = internal::max(internal::floor_div(dst_area.a[0] - o.origin[0], o.size), int32_t(0));
+				const int32_t last  = internal::min(internal::floor_div(dst_area.b[0] - 1 - o.origin[0], o.size) + 1, o.cells[0]);
+				for (;;) {
+					bool inside = true;
+					for (uint32_t i = 1; i < dimensions; ++i) {
+						cell[i] = internal::floor_div(run.a[i] - o.origin[i], o.size);
+						inside = inside && cell[i] >= 0 && cell[i] < o.cells[i];
+					}
+					if (inside) {
+						const uint64_t *row = o.bits + o.row(cell);
+						for (int32_t c = find(row, first, last, true); c < last; ) {
+							const int32_t e = find(row, c + 1, last, false);
+							run.a[0] = internal::max(o.origin[0] + c * o.size, dst_area.a[0]);
+							run.b[0] = internal::min(o.origin[0] + e * o.size, dst_area.b[0]);
+							for (uint32_t i = 0; i < dimensions; ++i) {
+								run_start[i] = internal::advance(src_start[i], src_delta[i], int64_t(run.a[i]) - dst_area.a[i]);
+							}
+							if (!row_major()(run, run_start, src_delta, processor)) { return false; }
+							c = find(row, e, last, true);
+						}
+					}
+					uint32_t i = 1;
+					for (; i < dimensions; ++i) {
+						if (++run.a[i] < dst_area.b[i]) {
+							run.b[i] = run.a[i] + 1;
+							break;
+						}
+						run.a[i] = dst_area.a[i];
+						run.b[i] = run.a[i] + 1;
+					}
+					if (i >= dimensions) { break; }
+				}
+				return true;
+			}
+		};
+
+		/// @brief A traversal policy for scaling an array into itself, such as when growing or shrinking an image inside its own buffer. Visits each axis in the direction that reads every source element before it is overwritten: forward where the source index is at or ahead of the destination index, and backward where it has fallen behind. Axes where the two cross are split at the crossing and each part is visited in its own direction.
+		/// @note The destination and source indices must address the same array with the same strides, so that equal indices refer to the same element. Axes must not be mirrored, since reversing data in place requires swapping elements. Row processors receive runs that never overwrite the source elements they read, so the SIMD kernels of write remain safe. Do not combine with scale_parallel, since tasks cannot coordinate their directions.
+		class in_place
+		{
+		private:
+			/// @brief Returns the source index along an axis at a destination index.
+			/// @tparam fixed_t The fixed-point type of the source index.
+			/// @param i The destination index.
+			/// @param a The destination index at which the source index is start.
+			/// @param start The source index at a.
+			/// @param delta The delta used to iterate through the source index.
+			/// @return The source index.
+			template < typename fixed_t >
+			static fixed_t source(int32_t i, int32_t a, fixed_t start, fixed_t delta)
+			{
+				return internal::advance(start, delta, int64_t(i) - a);
+			}
+
+			/// @brief Finds where the integer source index along an axis crosses the destination index. Since the difference between the two never increases when growing, and never decreases when shrinking, the crossing is found by bisection.
+			/// @tparam fixed_t The fixed-point type of the source index.
+			/// @param a The first destination index along the axis.
+			/// @param b The destination index past the last along the axis.
+			/// @param start The source index at a.
+			/// @param delta The delta used to iterate through the source index.
+			/// @param grow Determines if the axis is grown, i.e. if the delta is at most one.
+			/// @return The first destination index at which the source index is behind the destination index when growing, or at or ahead of it when shrinking, or b if there is none.
+			template < typename fixed_t >
+			static int32_t split(int32_t a, int32_t b, fixed_t start, fixed_t delta, bool grow)
+			{
+				int32_t lo = a, hi = b;
+				while (lo < hi) {
+					const int32_t mid = lo + (hi - lo) / 2;
+					const bool behind = int32_t(source(mid, a, start, delta)) < mid;
+					if (behind == grow) {
+						hi = mid;
+					} else {
+						lo = mid + 1;
+					}
+				}
+				return lo;
+			}
+
+			/// @brief Visits an axis, and recursively all inner axes, of a clipped destination area.
+			/// @tparam processor_t The type of the processor function/functor.
+			/// @tparam dimensions The number of dimensions to iterate over.
+			/// @tparam fixed_t The fixed-point type of the source index.
+			/// @param axis The axis to visit.
+			/// @param run The area visited. Outer axes span the single index being visited.
+			/// @param run_start The source index at the start of the area visited.
+			/// @param dst_area The clipped destination area.
+			/// @param src_start The source index at the start of the clipped destination area.
+			/// @param src_delta The delta used to iterate through the source index.
+			/// @param processor The processor function/functor to apply.
+			/// @return False if the processor stopped the traversal.
+			template < typename processor_t, uint32_t dimensions, typename fixed_t >
+			static bool visit(uint32_t axis, Area<int32_t,dimensions> &run, Point<fixed_t,dimensions> &run_start, const Area<int32_t,dimensions> &dst_area, const Point<fixed_t,dimensions> &src_start, const Point<fixed_t,dimensions> &src_delta, const processor_t &processor)
+			{
+				const int32_t a    = dst_area.a[axis];
+				const int32_t b    = dst_area.b[axis];
+				const bool    grow = src_delta[axis].value_bits <= fixed_t(1).value_bits;
+				const int32_t c    = split(a, b, src_start[axis], src_delta[axis], grow);
+				// Growing axes read behind the destination after the crossing, and shrinking axes before it. That part is visited backward, and first, so that the other part cannot read elements it has overwritten.
+				const int32_t back_a = grow ? c : a;
+				const int32_t back_b = grow ? b : c;
+				const int32_t fwd_a  = grow ? a : c;
+				const int32_t fwd_b  = grow ? c : b;
+				if (axis == 0) {
+					// Runs are written forward, so the part visited backward is split into runs that end before the first source element they read.
+					for (int32_t e = back_b; e > back_a; ) {
+						const int32_t behind = e - 1 - int32_t(source(e - 1, a, src_start[0], src_delta[0]));
+						const int32_t n      = internal::min(behind, e - back_a);
+						run.a[0] = e - n;
+						run.b[0] = e;
+						run_start[0] = source(run.a[0], a, src_start[0], src_delta[0]);
+						if (!row_major()(run, run_start, src_delta, processor)) { return false; }
+						e -= n;
+					}
+					if (fwd_a < fwd_b) {
+						run.a[0] = fwd_a;
+						run.b[0] = fwd_b;
+						run_start[0] = source(fwd_a, a, src_start[0], src_delta[0]);
+						if (!row_major()(run, run_start, src_delta, processor)) { return false; }
+					}
+					return true;
+				}
+				for (int32_t i = back_b - 1; i >= back_a; --i) {
+					run.a[axis] = i;
+					run.b[axis] = i + 1;
+					run_start[axis] = source(i, a, src_start[axis], src_delta[axis]);
+					if (!visit(axis - 1, run, run_start, dst_area, src_start, src_delta, processor)) { return false; }
+				}
+				for (int32_t i = fwd_a; i < fwd_b; ++i) {
+					run.a[axis] = i;
+					run.b[axis] = i + 1;
+					run_start[axis] = source(i, a, src_start[axis], src_delta[axis]);
+					if (!visit(axis - 1, run, run_start, dst_area, src_start, src_delta, processor)) { return false; }
+				}
+				return true;
+			}
+
+		public:
+			/// @brief Iterates over a clipped destination area in an order safe for scaling an array into itself.
+			/// @tparam processor_t The type of the processor function/functor.
+			/// @tparam dimensions The number of dimensions to iterate over.
+			/// @tparam fixed_t The fixed-point type of the source index.
+			/// @param dst_area The clipped destination area. All axes are in order.
+			/// @param src_start The source index at the start of the clipped destination area.
+			/// @param src_delta The delta used to iterate through the source index. Must not be negative.
+			/// @param processor The processor function/functor to apply.
+			/// @return False if the processor stopped the traversal.
+			template < typename processor_t, uint32_t dimensions, typename fixed_t >
+			bool operator()(const Area<int32_t,dimensions> &dst_area, const Point<fixed_t,dimensions> &src_start, const Point<fixed_t,dimensions> &src_delta, const processor_t &processor) const
+			{
+				Area<int32_t,dimensions> run = dst_area;
+				Point<fixed_t,dimensions> run_start = src_start;
+				return visit(dimensions - 1, run, run_start, dst_area, src_start, src_delta, processor);
+			}
+		};
+
+		/// @brief The reason a call to scale did not process any elements.
+		enum class skip_reason : uint8_t
+		{
+			none,       // Elements were processed.
+			empty_area, // The destination or source area has zero size along at least one axis.
+			masked      // The destination mask has zero size, or the destination area falls entirely outside of it.
+		};
+
+		namespace internal
+		{
+			/// @brief The instrumentation policy used when CC0_SCALE_INSTRUMENTATION is not defined. Compiles to nothing.
+			struct no_instrumentation
+			{
+				/// @brief Called before the clipped destination area is processed.
+				/// @tparam dimensions The number of dimensions of the area.
+				/// @param clipped The destination area clipped against the destination mask.
+				/// @param elements The number of elements in the clipped area.
+				template < uint32_t dimensions >
+				no_instrumentation(const Area<int32_t,dimensions>&, uint64_t) {}
+
+				/// @brief Called instead of the constructor when there is nothing to process.
+				/// @param reason The reason nothing was processed.
+				static void skipped(skip_reason) {}
+			};
+
+			// The instrumentation policy. Constructed before the clipped area is processed and destroyed on completion.
+#if defined(CC0_SCALE_INSTRUMENTATION)
+			typedef CC0_SCALE_INSTRUMENTATION instrumentation;
+#else
+			typedef no_instrumentation instrumentation;
+#endif
+		}
+
+		/// @brief The clipped destination area, source start, and source delta of a call to scale, computed once and reused by execute. Useful when the same geometry is scaled repeatedly, e.g. once per frame.
+		/// @tparam dimensions The number of dimensions of the space to iterate over.
+		/// @tparam fixed_t The fixed-point type of the source index.
+		template < uint32_t dimensions, typename fixed_t = fixed32_t >
+		struct ScalePlan
+		{
+			Area<int32_t,dimensions>  dst_area;  // The destination area clipped against the destination mask. All axes are in order.
+			Point<fixed_t,dimensions> src_start; // The source index at the start of the clipped destination area.
+			Point<fixed_t,dimensions> src_delta; // The delta used to iterate through the source index.
+			bool                      empty;     // True if there is nothing to process.
+			skip_reason               reason;    // The reason there is nothing to process, or none.
+			const int32_t             *index;    // The source offsets along the innermost axis of each element in a row of the clipped destination area, or null. Set by tabulate.
+			const float               *weight;   // The weights along the innermost axis of each element in a row of the clipped destination area, or null. Set by tabulate.
+
+			/// @brief Creates an empty plan.
+			ScalePlan( void ) : empty(true), reason(skip_reason::empty_area), index(nullptr), weight(nullptr) {}
+
+			/// @brief Creates a plan scaling a source area across a destination area. Respects reversed axis sampling when an end point on an axis is less than the start point.
+			/// @param dst The destination area to scale the source area over.
+			/// @param src The source area to scale over the destination area.
+			/// @param mask A mask used to discard all processing on the destination buffer that falls outside of the area.
+			ScalePlan(Area<int32_t,dimensions> dst, Area<fixed_t,dimensions> src, Area<int32_t,dimensions> mask);
+		};
+
+		/// @brief The clipped destination area and the drift-free stepping state of a call to scale_exact, computed once and reused by execute_exact. Kept apart from ScalePlan, so that plans used by scale and execute do not pay for the extra division per axis.
+		/// @tparam dimensions The number of dimensions of the space to iterate over.
+		/// @tparam fixed_t The fixed-point type of the source index.
+		template < uint32_t dimensions, typename fixed_t = fixed32_t >
+		struct ExactPlan
+		{
+			ScalePlan<dimensions,fixed_t>            plan;  // The plan of the same areas, providing the clipped destination area.
+			Point<internal::dda<fixed_t>,dimensions> exact; // The drift-free stepping state of each axis.
+
+			/// @brief Creates an empty plan.
+			ExactPlan( void ) {}
+
+			/// @brief Creates a plan scaling a source area across a destination area without drift. Respects reversed axis sampling when an end point on an axis is less than the start point.
+			/// @param dst The destination area to scale the source area over.
+			/// @param src The source area to scale over the destination area.
+			/// @param mask A mask used to discard all processing on the destination buffer that falls outside of the area.
+			ExactPlan(Area<int32_t,dimensions> dst, Area<fixed_t,dimensions> src, Area<int32_t,dimensions> mask);
+		};
+
+		/// @brief Applies a processor function to the destination area of a plan.
+		/// @tparam processor_t The type of the processor function.
+		/// @tparam dimensions The number of dimensions of the space to iterate over.
+		/// @tparam fixed_t The fixed-point type of the source index.
+		/// @param plan The plan.
+		/// @param processor A function taking a destination index and a source index and performs computations.
+		/// @note Produces the same destination and source indices as scale with the areas the plan was created from.
+		/// @sa ScalePlan
+		template < typename processor_t, uint32_t dimensions, typename fixed_t >
+		void execute(const ScalePlan<dimensions,fixed_t> &plan, const processor_t &processor);
+
+		/// @brief Applies a processor function to the destination area of a plan in the order given by a traversal policy.
+		/// @tparam processor_t The type of the processor function.
+		/// @tparam dimensions The number of dimensions of the space to iterate over.
+		/// @tparam fixed_t The fixed-point type of the source index.
+		/// @tparam traversal_t The type of the traversal policy.
+		/// @param plan The plan.
+		/// @param processor A function taking a destination index and a source index and performs computations.
+		/// @param traversal The traversal policy determining the order in which the destination area is visited.
+		/// @sa ScalePlan
+		template < typename processor_t, uint32_t dimensions, typename fixed_t, typename traversal_t >
+		void execute(const ScalePlan<dimensions,fixed_t> &plan, const processor_t &processor, const traversal_t &traversal);
+
+		/// @brief Precomputes the source offsets, and optionally weights, along the innermost axis of a plan into caller-provided tables. Since every row of the clipped destination area shares the same mapping along the innermost axis, execute then feeds processors supporting tables from the tables rather than stepping and converting the source index of every element.
+		/// @tparam processor_t The type of the processor function. Must be able to fill the tables by being called as `processor.tabulate(src_start, src_delta, count, index, weight)`, and should be callable as `processor(dst_row_start, src_row_start, src_delta, index, weight, count)`.
+		/// @tparam dimensions The number of dimensions of the space to iterate over.
+		/// @tparam fixed_t The fixed-point type of the source index.
+		/// @param plan The plan. Keeps pointers to the tables, which must outlive it.
+		/// @param processor The processor defining the contents of the tables. Processors later executed with the plan must use the same source layout.
+		/// @param index The table of source offsets.
+		/// @param weight The table of weights. Can be null for processors not using weights.
+		/// @param capacity The number of elements in each table. Must be at least the width of the clipped destination area.
+		/// @return False, leaving the plan unchanged, if the tables are too small or could not be filled.
+		/// @sa write
+		/// @sa write_linear
+		template < typename processor_t, uint32_t dimensions, typename fixed_t >
+		bool tabulate(ScalePlan<dimensions,fixed_t> &plan, const processor_t &processor, int32_t *index, float *weight, int32_t capacity);
+
+		/// @brief Applies a processor function to the destination area of a plan, stepping through the source index using an integer step and a remainder accumulator rather than a truncated fixed-point delta. Source indices are the exact source positions rounded down, so long runs end exactly where the source area ends rather than falling short.
+		/// @tparam processor_t The type of the processor function.
+		/// @tparam dimensions The number of dimensions of the space to iterate over.
+		/// @tparam fixed_t The fixed-point type of the source index.
+		/// @param plan The plan.
+		/// @param processor A function taking a destination index and a source index and performs computations. Row processors are handed entire runs when the source delta along the innermost axis is exact, and otherwise the longest runs over which the source index advances by a constant delta.
+		/// @sa ExactPlan
+		template < typename processor_t, uint32_t dimensions, typename fixed_t >
+		void execute_exact(const ExactPlan<dimensions,fixed_t> &plan, const processor_t &processor);
+
+		/// @brief Creates plans for many pairs of destination and source areas sharing one destination mask, such as the quads drawn by a sprite compositor. Pairs with zero size or falling entirely outside of the mask are culled before any other setup, get no plan, and are reported to the instrumentation policy as skipped.
+		/// @note Pairs are planned 64 at a time. The pairs of a chunk are culled first, the source deltas of the remaining pairs are then divided out along every axis in one pass, and the plans are clipped last. For fixed-point types of up to 32 bits the divisions are done as doubles, which vectorize where the 64-bit integer division of a single plan does not, and give the same deltas.
+		/// @tparam dimensions The number of dimensions of the space to iterate over.
+		/// @tparam fixed_t The fixed-point type of the source index.
+		/// @param dst_areas The destination areas.
+		/// @param src_areas The source areas, one per destination area.
+		/// @param count The number of pairs.
+		/// @param dst_mask A mask used to discard all processing on the destination buffer that falls outside of the area.
+		/// @param plans Receives the plans of the pairs that were not culled, in order. Must have room for count plans.
+		/// @param entries Optionally receives the index of the pair each plan was created from. Can be null. Must otherwise have room for count indices.
+		/// @return The number of plans created. None of them are empty.
+		/// @sa execute_batch
+		template < uint32_t dimensions, typename fixed_t >
+		uint32_t plan_batch(const Area<int32_t,dimensions> *dst_areas, const Area<fixed_t,dimensions> *src_areas, uint32_t count, Area<int32_t,dimensions> dst_mask, ScalePlan<dimensions,fixed_t> *plans, uint32_t *entries = nullptr);
+
+		/// @brief Applies a processor function to the destination areas of several plans, in order.
+		/// @tparam processor_t The type of the processor function.
+		/// @tparam dimensions The number of dimensions of the space to iterate over.
+		/// @tparam fixed_t The fixed-point type of the source index.
+		/// @param plans The plans.
+		/// @param count The number of plans.
+		/// @param processor A function taking a destination index and a source index and performs computations.
+		/// @sa plan_batch
+		template < typename processor_t, uint32_t dimensions, typename fixed_t >
+		void execute_batch(const ScalePlan<dimensions,fixed_t> *plans, uint32_t count, const processor_t &processor);
+
+		/// @brief Applies a processor function to the destination areas of several plans, in order, visiting each destination area in the order given by a traversal policy.
+		/// @tparam processor_t The type of the processor function.
+		/// @tparam dimensions The number of dimensions of the space to iterate over.
+		/// @tparam fixed_t The fixed-point type of the source index.
+		/// @tparam traversal_t The type of the traversal policy.
+		/// @param plans The plans.
+		/// @param count The number of plans.
+		/// @param processor A function taking a destination index and a source index and performs computations.
+		/// @param traversal The traversal policy determining the order in which each destination area is visited.
+		/// @sa plan_batch
+		template < typename processor_t, uint32_t dimensions, typename fixed_t, typename traversal_t >
+		void execute_batch(const ScalePlan<dimensions,fixed_t> *plans, uint32_t count, const processor_t &processor, const traversal_t &traversal);
+
+		/// @brief Scales a source area across a destination area and applies a processor function. Respects reversed axis sampling when an end point on an axis is less than the start point.
+		/// @tparam processor_t The type of the processor function. Will most usefully be a functor containing data to scale.
+		/// @tparam dimensions The number of dimensions of the space to iterate over.
+		/// @tparam fixed_t The fixed-point type of the source index.
+		/// @param dst_area The destination area to scale the source area over.
+		/// @param src_area The source area to scale over the destination area.
+		/// @param processor A function taking a destination index and a source index and performs computations. Can, for instance, be used to scale a source array to fit into a destination array. If the processor can instead be called as `processor(dst_row_start, src_row_start, src_delta, count)` it is called once per run of the innermost axis rather than once per element.
+		/// @param dst_mask A mask used to discard all processing on the destination buffer that falls outside of the area. Can be used as a way to guard against sampling a destination array outside of accepted bounds, or allow for parallel processing by assigning different cores to different masks on the same destination array. In many cases using the bounds of the destination memory is desired.
+		/// @sa write
+		template < typename processor_t, uint32_t dimensions, typename fixed_t >
+		void scale(Area<int32_t,dimensions> dst_area, Area<fixed_t,dimensions> src_area, const processor_t &processor, Area<int32_t,dimensions> dst_mask);
+
+		/// @brief Scales a source area across a destination area and applies a processor function in the order given by a traversal policy. Respects reversed axis sampling when an end point on an axis is less than the start point.
+		/// @tparam processor_t The type of the processor function. Will most usefully be a functor containing data to scale.
+		/// @tparam dimensions The number of dimensions of the space to iterate over.
+		/// @tparam fixed_t The fixed-point type of the source index.
+		/// @tparam traversal_t The type of the traversal policy.
+		/// @param dst_area The destination area to scale the source area over.
+		/// @param src_area The source area to scale over the destination area.
+		/// @param processor A function taking a destination index and a source index and performs computations.
+		/// @param dst_mask A mask used to discard all processing on the destination buffer that falls outside of the area.
+		/// @param traversal The traversal policy determining the order in which the destination area is visited.
+		/// @sa row_major
+		/// @sa tiled
+		template < typename processor_t, uint32_t dimensions, typename fixed_t, typename traversal_t >
+		void scale(Area<int32_t,dimensions> dst_area, Area<fixed_t,dimensions> src_area, const processor_t &processor, Area<int32_t,dimensions> dst_mask, const traversal_t &traversal);
+
+		/// @brief Scales a source area across a destination area and applies a processor function, stepping through the source index without drift. Respects reversed axis sampling when an end point on an axis is less than the start point.
+		/// @tparam processor_t The type of the processor function.
+		/// @tparam dimensions The number of dimensions of the space to iterate over.
+		/// @tparam fixed_t The fixed-point type of the source index.
+		/// @param dst_area The destination area to scale the source area over.
+		/// @param src_area The source area to scale over the destination area.
+		/// @param processor A function taking a destination index and a source index and performs computations.
+		/// @param dst_mask A mask used to discard all processing on the destination buffer that falls outside of the area.
+		/// @sa execute_exact
+		template < typename processor_t, uint32_t dimensions, typename fixed_t >
+		void scale_exact(Area<int32_t,dimensions> dst_area, Area<fixed_t,dimensions> src_area, const processor_t &processor, Area<int32_t,dimensions> dst_mask);
+
+		/// @brief Scales many pairs of destination and source areas sharing one destination mask and processor, in order. Equivalent to calling scale once per pair, but with the setup of plan_batch. Same as plan_batch followed by execute_batch, except that each chunk of plans is executed right after it is planned, while the plans are still in cache.
+		/// @tparam processor_t The type of the processor function.
+		/// @tparam dimensions The number of dimensions of the space to iterate over.
+		/// @tparam fixed_t The fixed-point type of the source index.
+		/// @param dst_areas The destination areas.
+		/// @param src_areas The source areas, one per destination area.
+		/// @param count The number of pairs.
+		/// @param processor A function taking a destination index and a source index and performs computations.
+		/// @param dst_mask A mask used to discard all processing on the destination buffer that falls outside of the area.
+		/// @param plans Scratch space for the plans. Must have room for count plans.
+		/// @return The number of pairs that were not culled.
+		/// @sa plan_batch
+		template < typename processor_t, uint32_t dimensions, typename fixed_t >
+		uint32_t scale_batch(const Area<int32_t,dimensions> *dst_areas, const Area<fixed_t,dimensions> *src_areas, uint32_t count, const processor_t &processor, Area<int32_t,dimensions> dst_mask, ScalePlan<dimensions,fixed_t> *plans);
+
+		/// @brief Assigns the entries of a batch to the square destination tiles they overlap, so that all entries overlapping a tile can be processed while the tile is in cache. Tiles are aligned to the start of the destination mask, and the last tile along an axis is cut short by the end of the mask. Tiles are numbered in row-major order.
+		/// @tparam dimensions The number of dimensions of the space to iterate over.
+		/// @tparam fixed_t The fixed-point type of the source index.
+		template < uint32_t dimensions, typename fixed_t = fixed32_t >
+		struct TileBins
+		{
+			Area<int32_t,dimensions>             mask;    // The destination mask. All axes are in order.
+			int32_t                              size;    // The length of each tile along every axis.
+			Point<int32_t,dimensions>            tiles;   // The number of tiles along each axis.
+			uint32_t                             count;   // The total number of tiles.
+			const uint32_t                      *offsets; // The entries of tile i are stored in [offsets[i], offsets[i + 1]) in entries.
+			const uint32_t                      *entries; // The indices into plans of the plans overlapping each tile, in submission order within each tile.
+			const ScalePlan<dimensions,fixed_t> *plans;   // The plans of the pairs that were not culled, in submission order.
+
+			static constexpr uint64_t MAX_TILES = 0x7fffffff; // The largest number of tiles, so that tile indices and the number of tiles along each axis fit in int32_t.
+
+			/// @brief Creates empty bins.
+			TileBins( void ) : size(1), count(0), offsets(nullptr), entries(nullptr), plans(nullptr) {}
+
+			/// @brief Returns the destination area of a tile, clipped against the destination mask.
+			/// @param i The index of the tile.
+			/// @return The area of the tile.
+			Area<int32_t,dimensions> tile(uint32_t i) const
+			{
+				Area<int32_t,dimensions> area;
+				for (uint32_t j = 0; j < dimensions; ++j) {
+					const int64_t t = int64_t(i % uint32_t(tiles[j]));
+					i /= uint32_t(tiles[j]);
+					const int64_t a = int64_t(mask.a[j]) + t * size;
+					area.a[j] = int32_t(a);
+					area.b[j] = a + size < int64_t(mask.b[j]) ? int32_t(a + size) : mask.b[j];
+				}
+				return area;
+			}
+
+			/// @brief Returns the number of tiles a destination mask is divided into.
+			/// @param dst_mask The destination mask.
+			/// @param tile_size The length of each tile along every axis.
+			/// @return The number of tiles, which is the number of offsets bin_batch needs minus one. Saturates at MAX_TILES + 1, which bin_batch rejects.
+			static uint64_t tile_count(const Area<int32_t,dimensions> &dst_mask, int32_t tile_size)
+			{
+				if (tile_size <= 0) { return MAX_TILES + 1; }
+				uint64_t n = 1;
+				for (uint32_t i = 0; i < dimensions; ++i) {
+					const int64_t length = dst_mask.b[i] > dst_mask.a[i] ? int64_t(dst_mask.b[i]) - dst_mask.a[i] : int64_t(dst_mask.a[i]) - dst_mask.b[i];
+					n *= uint64_t((length + tile_size - 1) / tile_size);
+					if (n > MAX_TILES) { return MAX_TILES + 1; }
+				}
+				return n;
+			}
+		};
+
+		/// @brief Plans pairs of destination and source areas once and assigns the plans to the destination tiles they overlap using caller-provided storage. Pairs with zero size or falling entirely outside of the mask are culled.
+		/// @tparam dimensions The number of dimensions of the space to iterate over.
+		/// @tparam fixed_t The fixed-point type of the source index.
+		/// @param bins Receives the bins. Keeps pointers to the plans, offsets, and entries, which must outlive it.
+		/// @param dst_areas The destination areas.
+		/// @param src_areas The source areas, one per destination area.
+		/// @param count The number of pairs.
+		/// @param dst_mask A mask used to discard all processing on the destination buffer that falls outside of the area.
+		/// @param tile_size The length of each tile along every axis.
+		/// @param plans Receives the plans of the pairs that were not culled, as by plan_batch. Must have room for count plans.
+		/// @param offsets Receives the start of the entries of each tile. Must have room for TileBins::tile_count(dst_mask, tile_size) + 1 offsets.
+		/// @param offset_capacity The number of elements in offsets.
+		/// @param entries Receives the pairs overlapping each tile.
+		/// @param entry_capacity The number of elements in entries. A pair is stored once per tile it overlaps.
+		/// @return False, leaving the bins empty and the plans unchanged, if the mask is divided into more than TileBins::MAX_TILES tiles, or if offsets or entries is too small.
+		/// @sa scale_binned
+		/// @sa plan_batch
+		template < uint32_t dimensions, typename fixed_t >
+		bool bin_batch(TileBins<dimensions,fixed_t> &bins, const Area<int32_t,dimensions> *dst_areas, const Area<fixed_t,dimensions> *src_areas, uint32_t count, Area<int32_t,dimensions> dst_mask, int32_t tile_size, ScalePlan<dimensions,fixed_t> *plans, uint32_t *offsets, uint32_t offset_capacity, uint32_t *entries, uint32_t entry_capacity);
+
+		/// @brief Executes the plans in a set of bins one destination tile at a time, processing every plan overlapping a tile, in submission order, before moving on to the next tile. Each plan is clipped against the tile rather than rebuilt from its areas. Each tile is handed to an executor as a separate task.
+		/// @tparam processor_t The type of the processor function. Must be safe to call from several threads at once if the executor runs tasks concurrently.
+		/// @tparam dimensions The number of dimensions of the space to iterate over.
+		/// @tparam fixed_t The fixed-point type of the source index.
+		/// @tparam executor_t The type of the executor running the tiles.
+		/// @param bins The bins created by bin_batch.
+		/// @param processor A function taking a destination index and a source index and performs computations.
+		/// @param executor The executor running the tiles. Returns once all tiles have been processed.
+		/// @note Every pair produces the same destination and source indices as scale with the same mask, only split across tiles.
+		/// @sa bin_batch
+		/// @sa serial_executor
+		template < typename processor_t, uint32_t dimensions, typename fixed_t, typename executor_t >
+		void scale_binned(const TileBins<dimensions,fixed_t> &bins, const processor_t &processor, const executor_t &executor);
+
+		/// @brief Scales a source area across a destination area known at compile-time and applies a processor function. The clipped area, source start, and source delta are computed at compile-time, and short rows are unrolled into straight-line code.
+		/// @tparam dst_area_t The destination area as a StaticArea.
+		/// @tparam src_area_t The source area as a StaticArea, in whole source elements.
+		/// @tparam dst_mask_t The destination mask as a StaticArea. Defaults to the destination area.
+		/// @tparam processor_t The type of the processor function.
+		/// @param processor A function taking a destination index and a source index and performs computations.
+		/// @note Produces the same destination and source indices as scale with the same areas.
+		/// @sa StaticArea
+		template < typename dst_area_t, typename src_area_t, typename dst_mask_t = dst_area_t, typename processor_t >
+		void scale(const processor_t &processor);
+
+		/// @brief An executor that runs all tasks in order on the calling thread.
+		/// @note Executors are objects that report how many tasks they can run concurrently via `size()`, and that run `task(i)` for each `i` in `[0, count)` when called as `executor(count, task)`, only returning once all tasks have completed. Wrap an existing job system in an object with the same members to use it with `scale_parallel`.
+		class serial_executor
+		{
+		public:
+			/// @brief Returns the number of tasks that can run concurrently.
+			/// @return One.
+			uint32_t size( void ) const { return 1; }
+
+			/// @brief Runs tasks in order.
+			/// @tparam task_t The type of the task function/functor.
+			/// @param count The number of tasks to run.
+			/// @param task The task function/functor called with the index of each task.
+			template < typename task_t >
+			void operator()(uint32_t count, const task_t &task) const
+			{
+				for (uint32_t i = 0; i < count; ++i) {
+					task(i);
+				}
+			}
+		};
+
+		/// @brief Scales a source area across a destination area and applies a processor function on several threads by dividing the destination mask into one tile per concurrent task along the outermost axis.
+		/// @tparam processor_t The type of the processor function. Must be safe to call from several threads at once.
+		/// @tparam dimensions The number of dimensions of the space to iterate over.
+		/// @tparam fixed_t The fixed-point type of the source index.
+		/// @tparam executor_t The type of the executor running the tiles.
+		/// @param dst_area The destination area to scale the source area over.
+		/// @param src_area The source area to scale over the destination area.
+		/// @param processor A function taking a destination index and a source index and performs computations.
+		/// @param dst_mask A mask used to discard all processing on the destination buffer that falls outside of the area.
+		/// @param executor The executor running the tiles. Returns once all tiles have been processed.
+		/// @note Produces the same destination and source indices as scale with the same parameters.
+		/// @sa scale
+		/// @sa serial_executor
+		template < typename processor_t, uint32_t dimensions, typename fixed_t, typename executor_t >
+		void scale_parallel(Area<int32_t,dimensions> dst_area, Area<fixed_t,dimensions> src_area, const processor_t &processor, Area<int32_t,dimensions> dst_mask, const executor_t &executor);
+
+		/// @brief Scales a 2D source area across a 2D destination area by filtering along axis 0 and then along axis 1, caching intermediate rows in a caller-provided ring buffer. Filtering one axis at a time costs O(taps * 2) rather than O(taps^2) per destination element.
+		/// @tparam filter_t The filter, such as linear_filter or box_filter.
+		/// @tparam dst_t The type of the destination array.
+		/// @tparam src_t The type of the source array.
+		/// @param dst_area The destination area to scale the source area over.
+		/// @param src_area The source area to scale over the destination area.
+		/// @param engine The arrays and intermediate row cache.
+		/// @param dst_mask A mask used to discard all processing on the destination buffer that falls outside of the area.
+		/// @return False, without writing to the destination, if the ring buffer is too small for the areas.
+		/// @sa separable
+		template < typename filter_t, typename dst_t, typename src_t >
+		bool scale_separable(Area<int32_t,2> dst_area, Area<fixed32_t,2> src_area, const separable<filter_t,dst_t,src_t> &engine, Area<int32_t,2> dst_mask);
+
+		/// @brief A level of an image pyramid, such as a mipmap, stored in a caller-provided array.
+		/// @tparam type_t The type of the array.
+		/// @tparam dimensions The number of dimensions of the array.
+		/// @sa build_pyramid
+		template < typename type_t, uint32_t dimensions >
+		struct PyramidLevel
+		{
+			type_t                    *data;   // The array.
+			Point<int32_t,dimensions>  stride; // The number of elements between two adjacent indices on each axis.
+			Point<int32_t,dimensions>  size;   // The number of elements along each axis.
+
+			/// @brief Returns the size of a level of a pyramid, halving the size of the source once per level and rounding down, but never to less than one element.
+			/// @param src_size The number of source elements along each axis.
+			/// @param level The level, where 0 is the source.
+			/// @return The number of elements along each axis.
+			static Point<int32_t,dimensions> size_of(const Point<int32_t,dimensions> &src_size, uint32_t level)
+			{
+				Point<int32_t,dimensions> size;
+				for (uint32_t i = 0; i < dimensions; ++i) {
+					size[i] = level < 31 && (src_size[i] >> level) > 1 ? src_size[i] >> level : 1;
+				}
+				return size;
+			}
+
+			/// @brief Returns the number of levels below the source in a full pyramid, i.e. until every axis is one element long.
+			/// @param src_size The number of source elements along each axis.
+			/// @return The number of levels.
+			static uint32_t count(const Point<int32_t,dimensions> &src_size)
+			{
+				uint32_t n = 0;
+				for (uint32_t i = 0; i < dimensions; ++i) {
+					uint32_t m = 0;
+					while ((src_size[i] >> (m + 1)) > 0) { ++m; }
+					n = internal::max(n, m);
+				}
+				return n;
+			}
+		};
+
+		/// @brief The largest number of levels below the source that build_pyramid produces.
+		static constexpr uint32_t MAX_PYRAMID_LEVELS = 32;
+
+		/// @brief Builds the levels of an image pyramid, such as mipmaps, in a single pass over the source. Every level is box filtered from the level before it into caller-provided arrays, exactly like scaling each level with write_box from the previous one. But rather than completing one level before starting the next, slices along the outermost axis are produced as soon as the slices of the level before that they cover are done, so each level is read back while it is still in the cache instead of from memory.
+		/// @tparam dst_t The type of the levels.
+		/// @tparam src_t The type of the source array.
+		/// @tparam dimensions The number of dimensions of the arrays.
+		/// @param src The source array.
+		/// @param src_stride The number of source elements between two adjacent indices on each axis.
+		/// @param src_size The number of source elements along each axis. At most 65535 along every axis, which is the range of fixed32_t.
+		/// @param levels The levels below the source, from largest to smallest. Sizes are typically computed by PyramidLevel::size_of, but any sizes are allowed.
+		/// @param count The number of levels. At most MAX_PYRAMID_LEVELS.
+		/// @return False, without writing to any level, if there are too many levels, or if any level, or the source, is empty.
+		/// @note Exact 2x reductions cover exactly two whole source elements per axis, so every element of such a level is the average of 2^dimensions elements of the level before.
+		/// @sa PyramidLevel
+		/// @sa write_box
+		template < typename dst_t, typename src_t, uint32_t dimensions >
+		bool build_pyramid(const src_t *src, const Point<int32_t,dimensions> &src_stride, const Point<int32_t,dimensions> &src_size, const PyramidLevel<dst_t,dimensions> *levels, uint32_t count);
+
+		/// @brief For internal use only. Do not use.
+		namespace internal
+		{
+			/// @brief Computes the part of a destination area that falls inside a destination mask.
+			/// @tparam dimensions The number of dimensions of the areas.
+			/// @param dst_area The destination area. Axes may be reversed.
+			/// @param dst_mask The destination mask. Axes may be reversed.
+			/// @param clipped The resulting area with all axes in order.
+			/// @return False if no part of the destination area falls inside the mask.
+			template < uint32_t dimensions >
+			inline bool clip(Area<int32_t,dimensions> dst_area, Area<int32_t,dimensions> dst_mask, Area<int32_t,dimensions> &clipped)
+			{
+				for (uint32_t i = 0; i < dimensions; ++i) {
+					if (dst_area.a[i] > dst_area.b[i]) { swap(dst_area.a[i], dst_area.b[i]); }
+					if (dst_mask.a[i] > dst_mask.b[i]) { swap(dst_mask.a[i], dst_mask.b[i]); }
+					clipped.a[i] = max(dst_area.a[i], dst_mask.a[i]);
+					clipped.b[i] = min(dst_area.b[i], dst_mask.b[i]);
+					if (clipped.a[i] >= clipped.b[i]) { return false; }
+				}
+				return true;
+			}
+
+			/// @brief Returns the number of elements in an area.
+			/// @tparam dimensions The number of dimensions of the area.
+			/// @param area The area. All axes must be in order.
+			/// @return The number of elements.
+			template < uint32_t dimensions >
+			inline uint64_t volume(const Area<int32_t,dimensions> &area)
+			{
+				uint64_t v = 1;
+				for (uint32_t i = 0; i < dimensions; ++i) {
+					v *= uint64_t(int64_t(area.b[i]) - area.a[i]);
+				}
+				return v;
+			}
+
+			/// @brief Determines if scale would process anything, without computing the source delta.
+			/// @tparam dimensions The number of dimensions of the areas.
+			/// @tparam fixed_t The fixed-point type of the source index.
+			/// @param dst_area The destination area. Axes may be reversed.
+			/// @param src_area The source area. Axes may be reversed.
+			/// @param dst_mask The destination mask. All axes must be in order.
+			/// @return The reason nothing would be processed, or none.
+			template < uint32_t dimensions, typename fixed_t >
+			inline skip_reason cull(const Area<int32_t,dimensions> &dst_area, const Area<fixed_t,dimensions> &src_area, const Area<int32_t,dimensions> &dst_mask)
+			{
+				for (uint32_t i = 0; i < dimensions; ++i) {
+					if (dst_area.a[i] == dst_area.b[i] || src_area.a[i].value_bits == src_area.b[i].value_bits) { return skip_reason::empty_area; }
+				}
+				for (uint32_t i = 0; i < dimensions; ++i) {
+					if (dst_mask.a[i] == dst_mask.b[i] || max(dst_area.a[i], dst_area.b[i]) <= dst_mask.a[i] || min(dst_area.a[i], dst_area.b[i]) >= dst_mask.b[i]) { return skip_reason::masked; }
+				}
+				return skip_reason::none;
+			}
+
+			/// @brief Computes the source index at the start of one axis of a plan from its source delta, and clips the axis of the destination area against the mask.
+			/// @tparam dimensions The number of dimensions of the areas.
+			/// @tparam fixed_t The fixed-point type of the source index.
+			/// @param dst The destination area. The axis must be in order and overlap the mask. Receives the clipped axis.
+			/// @param src The source area, reversed along the axis wherever the destination area was.
+			/// @param mask The destination mask. All axes must be in order.
+			/// @param delta The source delta along the axis.
+			/// @param i The axis.
+			/// @return The source index at the start of the clipped axis.
+			template < uint32_t dimensions, typename fixed_t >
+			inline fixed_t clip_axis(Area<int32_t,dimensions> &dst, const Area<fixed_t,dimensions> &src, const Area<int32_t,dimensions> &mask, fixed_t delta, uint32_t i)
+			{
+				// Compared by bits, since fixed values convert to integers when compared, which truncates them.
+				const fixed_t lo = src.a[i].value_bits < src.b[i].value_bits ? src.a[i] : src.b[i];
+				const fixed_t hi = src.a[i].value_bits < src.b[i].value_bits ? src.b[i] : src.a[i];
+				fixed_t start = lo;
+				if (delta.value_bits < 0) {
+					start = hi;
+					start += delta;
+				}
+				if (dst.a[i] < mask.a[i]) {
+					start = advance(start, delta, int64_t(mask.a[i]) - dst.a[i]);
+					dst.a[i] = mask.a[i];
+				}
+				if (dst.b[i] >= mask.b[i]) {
+					dst.b[i] = mask.b[i];
+				}
+				return start;
+			}
+
+			/// @brief The type plan_batch divides the distances between the ends of source areas by destination lengths in. Fixed-point types of up to 32 bits divide as doubles, which vectorizes across pairs where 64-bit integer division does not. The truncated quotient is exact, since both operands fit in the 53-bit mantissa, and a quotient that is not an integer lies at least 1 / length from one, far more than its rounding error.
+			/// @tparam fixed_t The fixed-point type of the source index.
+			/// @tparam narrow True if the fixed-point type is at most 32 bits wide.
+			template < typename fixed_t, bool narrow = (sizeof(typename fixed_t::int_t) <= 4) >
+			struct batch_quotient
+			{
+				typedef double type;
+			};
+
+			/// @brief Wider fixed-point types divide as 64-bit integers.
+			/// @tparam fixed_t The fixed-point type of the source index.
+			template < typename fixed_t >
+			struct batch_quotient<fixed_t,false>
+			{
+				typedef uint64_t type;
+			};
+
+			/// @brief A task processing one tile of a call to scale_parallel.
+			/// @tparam processor_t The type of the processor function/functor.
+			/// @tparam dimensions The number of dimensions of the space to iterate over.
+			/// @tparam fixed_t The fixed-point type of the source index.
+			template < typename processor_t, uint32_t dimensions, typename fixed_t >
+			class parallel_task
+			{
+			private:
+				const Area<int32_t,dimensions>   &m_dst_area;  // The destination area.
+				const Area<fixed_t,dimensions>   &m_src_area;  // The source area.
+				const processor_t                &m_processor; // The processor.
+				const Area<int32_t,dimensions>   &m_clipped;   // The destination area clipped against the destination mask.
+				uint32_t                          m_count;     // The number of tiles.
+
+			public:
+				/// @brief Creates a new task.
+				/// @param dst_area The destination area.
+				/// @param src_area The source area.
+				/// @param processor The processor.
+				/// @param clipped The destination area clipped against the destination mask.
+				/// @param count The number of tiles.
+				parallel_task(const Area<int32_t,dimensions> &dst_area, const Area<fixed_t,dimensions> &src_area, const processor_t &processor, const Area<int32_t,dimensions> &clipped, uint32_t count) : m_dst_area(dst_area), m_src_area(src_area), m_processor(processor), m_clipped(clipped), m_count(count) {}
+
+				/// @brief Processes a tile.
+				/// @param i The index of the tile.
+				void operator()(uint32_t i) const
+				{
+					static constexpr uint32_t AXIS = dimensions - 1;
+					const int64_t length = m_clipped.b[AXIS] - m_clipped.a[AXIS];
+					Area<int32_t,dimensions> tile = m_clipped;
+					tile.a[AXIS] = m_clipped.a[AXIS] + int32_t(length * i / m_count);
+					tile.b[AXIS] = m_clipped.a[AXIS] + int32_t(length * (i + 1) / m_count);
+					if (tile.a[AXIS] < tile.b[AXIS]) {
+						scale(m_dst_area, m_src_area, m_processor, tile);
+					}
+				}
+			};
+
+			/// @brief Clips a plan against a destination area, advancing the source index and the tables of the plan to the start of the clipped area rather than replanning from the original areas.
+			/// @tparam dimensions The number of dimensions of the space to iterate over.
+			/// @tparam fixed_t The fixed-point type of the source index.
+			/// @param plan The plan to clip. Must not be empty.
+			/// @param area The area to clip against. All axes must be in order.
+			/// @param out Receives the clipped plan.
+			/// @return False, leaving out unchanged, if the plan does not overlap the area.
+			/// @note The clipped plan produces the same destination and source indices as a plan created from the original areas with the intersection of both masks.
+			template < uint32_t dimensions, typename fixed_t >
+			inline bool clip_plan(const ScalePlan<dimensions,fixed_t> &plan, const Area<int32_t,dimensions> &area, ScalePlan<dimensions,fixed_t> &out)
+			{
+				Area<int32_t,dimensions> dst;
+				for (uint32_t i = 0; i < dimensions; ++i) {
+					dst.a[i] = max(plan.dst_area.a[i], area.a[i]);
+					dst.b[i] = min(plan.dst_area.b[i], area.b[i]);
+					if (dst.a[i] >= dst.b[i]) { return false; }
+				}
+				out = plan;
+				out.dst_area = dst;
+				for (uint32_t i = 0; i < dimensions; ++i) {
+					const uint64_t k = uint64_t(int64_t(dst.a[i]) - plan.dst_area.a[i]);
+					if (k == 0) { continue; }
+					out.src_start[i] = advance(out.src_start[i], plan.src_delta[i], int64_t(k));
+				}
+				const int32_t skip = dst.a[0] - plan.dst_area.a[0];
+				if (out.index != nullptr)  { out.index += skip; }
+				if (out.weight != nullptr) { out.weight += skip; }
+				return true;
+			}
+
+			/// @brief A task processing all plans overlapping one tile of a call to scale_binned.
+			/// @tparam processor_t The type of the processor function/functor.
+			/// @tparam dimensions The number of dimensions of the space to iterate over.
+			/// @tparam fixed_t The fixed-point type of the source index.
+			template < typename processor_t, uint32_t dimensions, typename fixed_t >
+			class binned_task
+			{
+			private:
+				const TileBins<dimensions,fixed_t> &m_bins;      // The bins.
+				const processor_t                  &m_processor; // The processor.
+
+			public:
+				/// @brief Creates a new task.
+				/// @param bins The bins.
+				/// @param processor The processor.
+				binned_task(const TileBins<dimensions,fixed_t> &bins, const processor_t &processor) : m_bins(bins), m_processor(processor) {}
+
+				/// @brief Processes a tile.
+				/// @param i The index of the tile.
+				void operator()(uint32_t i) const
+				{
+					const Area<int32_t,dimensions> tile = m_bins.tile(i);
+					ScalePlan<dimensions,fixed_t> clipped;
+					for (uint32_t j = m_bins.offsets[i]; j < m_bins.offsets[i + 1]; ++j) {
+						if (clip_plan(m_bins.plans[m_bins.entries[j]], tile, clipped)) {
+							execute(clipped, m_processor);
+						}
+					}
+				}
+			};
+
+			/// @brief Calls a function with the index of every tile overlapped by a destination area.
+			/// @tparam dimensions The number of dimensions of the space to iterate over.
+			/// @tparam function_t The type of the function.
+			/// @param bins The bins defining the tiles. Only the mask, size, and tiles are used.
+			/// @param dst_area The destination area. Must overlap the mask.
+			/// @param function The function called with the index of each tile.
+			template < uint32_t dimensions, typename fixed_t, typename function_t >
+			inline void for_each_tile(const TileBins<dimensions,fixed_t> &bins, const Area<int32_t,dimensions> &dst_area, const function_t &function)
+			{
+				Point<int32_t,dimensions> lo, hi, t;
+				for (uint32_t i = 0; i < dimensions; ++i) {
+					const int64_t a = max(min(dst_area.a[i], dst_area.b[i]), bins.mask.a[i]);
+					const int64_t b = min(max(dst_area.a[i], dst_area.b[i]), bins.mask.b[i]);
+					lo[i] = int32_t((a - bins.mask.a[i]) / bins.size);
+					hi[i] = int32_t((b - 1 - bins.mask.a[i]) / bins.size);
+					t[i] = lo[i];
+				}
+				for (;;) {
+					uint32_t index = 0;
+					for (uint32_t i = dimensions; i > 0; --i) {
+						index = index * uint32_t(bins.tiles[i - 1]) + uint32_t(t[i - 1]);
+					}
+					function(index);
+					uint32_t i = 0;
+					for (; i < dimensions; ++i) {
+						if (t[i] < hi[i]) {
+							++t[i];
+							break;
+						}
+						t[i] = lo[i];
+					}
+					if (i == dimensions) { break; }
+				}
+			}
+
+			/// @brief Counts the plans overlapping each tile.
+			struct count_tile
+			{
+				uint32_t *offsets; // Receives the counts, offset by one.
+
+				/// @brief Counts a plan overlapping a tile.
+				/// @param i The index of the tile.
+				void operator()(uint32_t i) const { ++offsets[i + 1]; }
+			};
+
+			/// @brief Stores a plan in each tile it overlaps.
+			struct fill_tile
+			{
+				uint32_t *offsets; // The next free slot of each tile.
+				uint32_t *entries; // Receives the plans.
+				uint32_t  entry;   // The plan.
+
+				/// @brief Stores the plan in a tile.
+				/// @param i The index of the tile.
+				void operator()(uint32_t i) const { entries[offsets[i]++] = entry; }
+			};
+
+			/// @brief A row processor feeding a processor supporting index tables from the tables of a plan.
+			/// @tparam processor_t The type of the processor function/functor.
+			/// @tparam dimensions The number of dimensions of the space to iterate over.
+			/// @tparam fixed_t The fixed-point type of the source index.
+			template < typename processor_t, uint32_t dimensions, typename fixed_t >
+			class table_rows
+			{
+			private:
+				const processor_t &m_processor; // The processor.
+				const int32_t     *m_index;     // The source offsets of the first element in a row along the innermost axis.
+				const float       *m_weight;    // The weights of the first element in a row along the innermost axis, or null.
+				int32_t            m_start;     // The destination index along the innermost axis of the first element in the tables.
+
+			public:
+				/// @brief Creates a new row processor.
+				/// @param processor The processor.
+				/// @param plan The plan containing the tables.
+				table_rows(const processor_t &processor, const ScalePlan<dimensions,fixed_t> &plan) : m_processor(processor), m_index(plan.index), m_weight(plan.weight), m_start(plan.dst_area.a[0]) {}
+
+				/// @brief Hands a run over to the processor along with the part of the tables covering it.
+				/// @param dst The destination array index of the first element in the run.
+				/// @param src The source array index of the first element in the run.
+				/// @param src_delta The delta used to iterate through the source index.
+				/// @param count The number of elements in the run.
+				void operator()(const Point<int32_t,dimensions> &dst, const Point<fixed_t,dimensions> &src, const Point<fixed_t,dimensions> &src_delta, int32_t count) const
+				{
+					const int32_t i = dst[0] - m_start;
+					m_processor(dst, src, src_delta, m_index + i, m_weight != nullptr ? m_weight + i : nullptr, count);
+				}
+			};
+
+			/// @brief Runs a plan.
+			/// @tparam tables True if the processor supports index tables.
+			template < bool tables >
+			struct plan_runner
+			{
+				/// @brief Runs a plan.
+				/// @tparam processor_t The type of the processor function/functor.
+				/// @tparam dimensions The number of dimensions of the space to iterate over.
+				/// @tparam fixed_t The fixed-point type of the source index.
+				/// @tparam traversal_t The type of the traversal policy.
+				/// @param plan The plan.
+				/// @param processor The processor.
+				/// @param traversal The traversal policy.
+				template < typename processor_t, uint32_t dimensions, typename fixed_t, typename traversal_t >
+				static void run(const ScalePlan<dimensions,fixed_t> &plan, const processor_t &processor, const traversal_t &traversal)
+				{
+					traversal(plan.dst_area, plan.src_start, plan.src_delta, processor);
+				}
+			};
+
+			/// @brief Runs a plan, feeding the processor from the tables of the plan if there are any.
+			template <>
+			struct plan_runner<true>
+			{
+				/// @brief Runs a plan.
+				/// @tparam processor_t The type of the processor function/functor.
+				/// @tparam dimensions The number of dimensions of the space to iterate over.
+				/// @tparam fixed_t The fixed-point type of the source index.
+				/// @tparam traversal_t The type of the traversal policy.
+				/// @param plan The plan.
+				/// @param processor The processor.
+				/// @param traversal The traversal policy.
+				template < typename processor_t, uint32_t dimensions, typename fixed_t, typename traversal_t >
+				static void run(const ScalePlan<dimensions,fixed_t> &plan, const processor_t &processor, const traversal_t &traversal)
+				{
+					if (plan.index != nullptr) {
+						traversal(plan.dst_area, plan.src_start, plan.src_delta, table_rows<processor_t,dimensions,fixed_t>(processor, plan));
+					} else {
+						traversal(plan.dst_area, plan.src_start, plan.src_delta, processor);
+					}
+				}
+			};
+
+			/// @brief A processor doing nothing. Used when a traversal policy does all the work.
+			/// @tparam dimensions The number of dimensions of the space to iterate over.
+			template < uint32_t dimensions >
+			struct no_processor
+			{
+				/// @brief Does nothing.
+				void operator()(const Point<int32_t,dimensions>&, const Point<fixed32_t,dimensions>&) const {}
+			};
+
+			/// @brief A traversal policy handing the clipped destination area of a call to scale over to the engine of scale_separable.
+			/// @tparam engine_t The type of the engine.
+			template < typename engine_t >
+			class separable_pass
+			{
+			private:
+				const engine_t &m_engine; // The engine.
+
+			public:
+				/// @brief Creates a new traversal policy.
+				/// @param engine The engine.
+				explicit separable_pass(const engine_t &engine) : m_engine(engine) {}
+
+				/// @brief Hands the clipped destination area over to the engine.
+				/// @tparam processor_t The type of the processor function/functor. Unused.
+				/// @param dst_area The clipped destination area. All axes are in order.
+				/// @param src_start The source index at the start of the clipped destination area.
+				/// @param src_delta The delta used to iterate through the source index.
+				template < typename processor_t >
+				void operator()(const Area<int32_t,2> &dst_area, const Point<fixed32_t,2> &src_start, const Point<fixed32_t,2> &src_delta, const processor_t&) const
+				{
+					m_engine(dst_area, src_start, src_delta);
+				}
+			};
+
+			/// @brief Returns the number of slices along the outermost axis of a level of a pyramid that must be done before a slice of the next level can be produced.
+			/// @param size The number of slices of the next level.
+			/// @param src_size The number of slices of the level.
+			/// @param slice The slice of the next level.
+			/// @return One past the last slice of the level covered by the slice.
+			inline int32_t pyramid_needs(int32_t size, int32_t src_size, int32_t slice)
+			{
+				fixed32_t delta, start;
+				delta.value_bits = int32_t((int64_t(src_size) << 15) / size);
+				start.value_bits = delta.value_bits * slice;
+				box_span span;
+				span.set(start, delta);
+				return min(span.last, src_size - 1) + 1;
+			}
+
+			/// @brief Produces one slice along the outermost axis of a level of a pyramid from the level before it.
+			/// @tparam dst_t The type of the level.
+			/// @tparam src_t The type of the level before it.
+			/// @tparam dimensions The number of dimensions of the arrays.
+			/// @param level The level.
+			/// @param src The level before it.
+			/// @param src_stride The number of elements between two adjacent indices on each axis of the level before it.
+			/// @param src_size The number of elements along each axis of the level before it.
+			/// @param slice The slice to produce.
+			template < typename dst_t, typename src_t, uint32_t dimensions >
+			inline void pyramid_slice(const PyramidLevel<dst_t,dimensions> &level, const src_t *src, const Point<int32_t,dimensions> &src_stride, const Point<int32_t,dimensions> &src_size, int32_t slice)
+			{
+				Area<int32_t,dimensions>   dst_area;
+				Area<fixed32_t,dimensions> src_area;
+				for (uint32_t i = 0; i < dimensions; ++i) {
+					dst_area.a[i] = 0;
+					dst_area.b[i] = level.size[i];
+					src_area.a[i] = fixed32_t(0);
+					src_area.b[i] = fixed32_t(src_size[i]);
+				}
+				Area<int32_t,dimensions> dst_mask = dst_area;
+				dst_mask.a[dimensions - 1] = slice;
+				dst_mask.b[dimensions - 1] = slice + 1;
+				execute(ScalePlan<dimensions>(dst_area, src_area, dst_mask), write_box<dst_t,src_t,dimensions>(level.data, level.stride, src, src_stride, src_size));
+			}
+		}
+	}
+}
+
+/// @brief Addition.
+/// @tparam bits The total number of bits for the base data type. Supported sizes are 8, 16, 32, and 64.
+/// @tparam precision The number of bits dedicated to decimals.
+/// @param l The left-hand side operand.
+/// @param r The right-hand side operand.
+/// @return The result.
+template < uint32_t bits, uint32_t precision > inline cc0::scale::fixed<bits,precision> operator+(cc0::scale::fixed<bits,precision> l, cc0::scale::fixed<bits,precision> r) { return l += r; }
+
+/// @brief Subtraction.
+/// @tparam bits The total number of bits for the base data type. Supported sizes are 8, 16, 32, and 64.
+/// @tparam precision The number of bits dedicated to decimals.
+/// @param l The left-hand side operand.
+/// @param r The right-hand side operand.
+/// @return The result.
+template < uint32_t bits, uint32_t precision > inline cc0::scale::fixed<bits,precision> operator-(cc0::scale::fixed<bits,precision> l, cc0::scale::fixed<bits,precision> r) { return l -= r; }
+
+/// @brief Multiplication.
+/// @tparam bits The total number of bits for the base data type. Supported sizes are 8, 16, 32, and 64.
+/// @tparam precision The number of bits dedicated to decimals.
+/// @param l The left-hand side operand.
+/// @param r The right-hand side operand.
+/// @return The result.
+template < uint32_t bits, uint32_t precision > inline cc0::scale::fixed<bits,precision> operator*(cc0::scale::fixed<bits,precision> l, cc0::scale::fixed<bits,precision> r) { return l *= r; }
+
+/// @brief Division.
+/// @tparam bits The total number of bits for the base data type. Supported sizes are 8, 16, 32, and 64.
+/// @tparam precision The number of bits dedicated to decimals.
+/// @param l The left-hand side operand.
+/// @param r The right-hand side operand.
+/// @return The result.
+template < uint32_t bits, uint32_t precision > inline cc0::scale::fixed<bits,precision> operator/(cc0::scale::fixed<bits,precision> l, cc0::scale::fixed<bits,precision> r) { return l /= r; }
+
+template < typename processor_t, uint32_t dimensions, typename fixed_t >
+void cc0::scale::scale(cc0::scale::Area<int32_t,dimensions> dst_area, cc0::scale::Area<fixed_t,dimensions> src_area, const processor_t &processor, cc0::scale::Area<int32_t,dimensions> dst_mask)
+{
+	scale(dst_area, src_area, processor, dst_mask, row_major());
+}
+
+template < uint32_t dimensions, typename fixed_t >
+cc0::scale::ScalePlan<dimensions,fixed_t>::ScalePlan(cc0::scale::Area<int32_t,dimensions> dst, cc0::scale::Area<fixed_t,dimensions> src, cc0::scale::Area<int32_t,dimensions> mask) : empty(true), reason(skip_reason::empty_area), index(nullptr), weight(nullptr)
+{
+	for (uint32_t i = 0; i < dimensions; ++i) {
+		if (mask.a[i] > mask.b[i]) { internal::swap(mask.a[i], mask.b[i]); }
+	}
+
+	for (uint32_t i = 0; i < dimensions; ++i) {
+		if (dst.a[i] == dst.b[i]) { return; }
+		if (src.a[i].value_bits == src.b[i].value_bits) { return; }
+	}
+	reason = skip_reason::masked;
+	for (uint32_t i = 0; i < dimensions; ++i) {
+		if (mask.a[i] == mask.b[i]) { return; }
+	}
+	for (uint32_t i = 0; i < dimensions; ++i) {
+		if (dst.a[i] > dst.b[i]) {
+			internal::swap(dst.a[i], dst.b[i]);
+			internal::swap(src.a[i], src.b[i]);
+		}
+		if (dst.b[i] <= mask.a[i] || dst.a[i] >= mask.b[i]) { return; }
+		// Divided by magnitude, since the signed difference of 64-bit formats does not fit in 64 bits.
+		const uint64_t length = uint64_t(int64_t(dst.b[i]) - dst.a[i]);
+		src_delta[i] = internal::from_magnitude<fixed_t>(internal::span(src.a[i], src.b[i]) / length, src.b[i].value_bits < src.a[i].value_bits);
+		src_start[i] = internal::clip_axis(dst, src, mask, src_delta[i], i);
+	}
+	dst_area = dst;
+	empty = false;
+	reason = skip_reason::none;
+}
+
+template < uint32_t dimensions, typename fixed_t >
+cc0::scale::ExactPlan<dimensions,fixed_t>::ExactPlan(cc0::scale::Area<int32_t,dimensions> dst, cc0::scale::Area<fixed_t,dimensions> src, cc0::scale::Area<int32_t,dimensions> mask) : plan(dst, src, mask)
+{
+	if (plan.empty) { return; }
+	for (uint32_t i = 0; i < dimensions; ++i) {
+		if (dst.a[i] > dst.b[i]) {
+			internal::swap(dst.a[i], dst.b[i]);
+			internal::swap(src.a[i], src.b[i]);
+		}
+		const uint64_t length   = uint64_t(int64_t(dst.b[i]) - dst.a[i]);
+		const uint64_t span     = internal::span(src.a[i], src.b[i]);
+		const bool     reversed = src.b[i].value_bits < src.a[i].value_bits;
+		// Compared by bits, since fixed values convert to integers when compared, which truncates them.
+		const fixed_t lo = src.a[i].value_bits < src.b[i].value_bits ? src.a[i] : src.b[i];
+		const fixed_t hi = src.a[i].value_bits < src.b[i].value_bits ? src.b[i] : src.a[i];
+		// Element k starts at floor((k + o) * diff / length) relative to the lower end of the source area, where diff is the signed difference of the source area and o is 1 for reversed axes.
+		// Split into k * quotient + floor(k * remainder / length), with the quotient rounded down and the remainder taken from the magnitude of diff, since diff itself does not fit in 64 bits for 64-bit fixed-point types while k * remainder does.
+		const uint64_t carry     = reversed && span % length != 0 ? 1 : 0;
+		const uint64_t remainder = carry != 0 ? length - span % length : span % length;
+		const uint64_t k         = uint64_t(int64_t(plan.dst_area.a[i]) - dst.a[i]) + (reversed ? 1 : 0);
+		exact[i].step = internal::from_magnitude<fixed_t>(span / length + carry, reversed);
+		exact[i].start = internal::advance(reversed ? hi : lo, exact[i].step, int64_t(k));
+		exact[i].start.value_bits += typename fixed_t::int_t(k * remainder / length);
+		exact[i].remainder = remainder;
+		exact[i].divisor = length;
+		exact[i].error = k * remainder % length;
+	}
+}
+
+template < typename processor_t, uint32_t dimensions, typename fixed_t, typename traversal_t >
+void cc0::scale::scale(cc0::scale::Area<int32_t,dimensions> dst_area, cc0::scale::Area<fixed_t,dimensions> src_area, const processor_t &processor, cc0::scale::Area<int32_t,dimensions> dst_mask, const traversal_t &traversal)
+{
+	execute(ScalePlan<dimensions,fixed_t>(dst_area, src_area, dst_mask), processor, traversal);
+}
+
+template < typename processor_t, uint32_t dimensions, typename fixed_t >
+void cc0::scale::execute(const cc0::scale::ScalePlan<dimensions,fixed_t> &plan, const processor_t &processor)
+{
+	execute(plan, processor, row_major());
+}
+
+template < typename processor_t, uint32_t dimensions, typename fixed_t, typename traversal_t >
+void cc0::scale::execute(const cc0::scale::ScalePlan<dimensions,fixed_t> &plan, const processor_t &processor, const traversal_t &traversal)
+{
+	if (plan.empty) {
+		internal::instrumentation::skipped(plan.reason);
+	} else {
+		const internal::instrumentation scope(plan.dst_area, internal::volume(plan.dst_area));
+		internal::plan_runner<internal::is_table_processor<processor_t,dimensions,fixed_t>::value>::run(plan, processor, traversal);
+		internal::finish(processor);
+	}
+}
+
+template < typename processor_t, uint32_t dimensions, typename fixed_t >
+void cc0::scale::execute_exact(const cc0::scale::ExactPlan<dimensions,fixed_t> &plan, const processor_t &processor)
+{
+	if (plan.plan.empty) {
+		internal::instrumentation::skipped(plan.plan.reason);
+	} else {
+		const internal::instrumentation scope(plan.plan.dst_area, internal::volume(plan.plan.dst_area));
+		Point<int32_t,dimensions> dst_index;
+		Point<fixed_t,dimensions> src_index;
+		internal::exact_iterator<dimensions-1,dimensions,processor_t,fixed_t>{}(dst_index, src_index, plan.plan.dst_area, plan.exact, processor);
+		internal::finish(processor);
+	}
+}
+
+template < uint32_t dimensions, typename fixed_t >
+uint32_t cc0::scale::plan_batch(const cc0::scale::Area<int32_t,dimensions> *dst_areas, const cc0::scale::Area<fixed_t,dimensions> *src_areas, uint32_t count, cc0::scale::Area<int32_t,dimensions> dst_mask, cc0::scale::ScalePlan<dimensions,fixed_t> *plans, uint32_t *entries)
+{
+	for (uint32_t i = 0; i < dimensions; ++i) {
+		if (dst_mask.a[i] > dst_mask.b[i]) { internal::swap(dst_mask.a[i], dst_mask.b[i]); }
+	}
+	// Pairs are planned in chunks which are first culled, then have the source deltas of all axes computed in one vectorizable pass, and are then clipped.
+	static constexpr uint32_t CHUNK = 64;
+	typedef typename internal::batch_quotient<fixed_t>::type quotient_t;
+	quotient_t               quotient[dimensions][CHUNK];
+	quotient_t               length[dimensions][CHUNK];
+	Area<fixed_t,dimensions> src[CHUNK];
+	for (uint32_t j = 0; j < dimensions; ++j) {
+		for (uint32_t k = 0; k < CHUNK; ++k) {
+			quotient[j][k] = 0;
+			length[j][k]   = 1;
+		}
+	}
+	uint32_t n = 0;
+	for (uint32_t first = 0; first < count; first += CHUNK) {
+		const uint32_t last = internal::min(count - first, CHUNK) + first;
+		uint32_t m = 0;
+		for (uint32_t i = first; i < last; ++i) {
+			const skip_reason reason = internal::cull(dst_areas[i], src_areas[i], dst_mask);
+			if (reason == skip_reason::none) {
+				Area<int32_t,dimensions> &dst = plans[n + m].dst_area;
+				dst = dst_areas[i];
+				src[m] = src_areas[i];
+				for (uint32_t j = 0; j < dimensions; ++j) {
+					if (dst.a[j] > dst.b[j]) {
+						internal::swap(dst.a[j], dst.b[j]);
+						internal::swap(src[m].a[j], src[m].b[j]);
+					}
+					length[j][m]   = quotient_t(uint64_t(int64_t(dst.b[j]) - dst.a[j]));
+					quotient[j][m] = quotient_t(internal::span(src[m].a[j], src[m].b[j]));
+				}
+				if (entries != nullptr) { entries[n + m] = i; }
+				++m;
+			} else {
+				internal::instrumentation::skipped(reason);
+			}
+		}
+		// Doubles divide the whole chunk, since a fixed number of divisions vectorizes, and the unused lanes hold earlier pairs or the initial values.
+		const uint32_t end = internal::is_same<quotient_t,double>::value ? CHUNK : m;
+		for (uint32_t j = 0; j < dimensions; ++j) {
+			for (uint32_t k = 0; k < end; ++k) {
+				quotient[j][k] /= length[j][k];
+			}
+		}
+		for (uint32_t k = 0; k < m; ++k) {
+			ScalePlan<dimensions,fixed_t> &plan = plans[n + k];
+			for (uint32_t j = 0; j < dimensions; ++j) {
+				plan.src_delta[j] = internal::from_magnitude<fixed_t>(uint64_t(quotient[j][k]), src[k].b[j].value_bits < src[k].a[j].value_bits);
+				plan.src_start[j] = internal::clip_axis(plan.dst_area, src[k], dst_mask, plan.src_delta[j], j);
+			}
+			plan.empty  = false;
+			plan.reason = skip_reason::none;
+			plan.index  = nullptr;
+			plan.weight = nullptr;
+		}
+		n += m;
+	}
+	return n;
+}
+
+template < typename processor_t, uint32_t dimensions, typename fixed_t >
+void cc0::scale::execute_batch(const cc0::scale::ScalePlan<dimensions,fixed_t> *plans, uint32_t count, const processor_t &processor)
+{
+	execute_batch(plans, count, processor, row_major());
+}
+
+template < typename processor_t, uint32_t dimensions, typename fixed_t, typename traversal_t >
+void cc0::scale::execute_batch(const cc0::scale::ScalePlan<dimensions,fixed_t> *plans, uint32_t count, const processor_t &processor, const traversal_t &traversal)
+{
+	for (uint32_t i = 0; i < count; ++i) {
+		execute(plans[i], processor, traversal);
+	}
+}
+
+template < typename processor_t, uint32_t dimensions, typename fixed_t >
+void cc0::scale::scale_exact(cc0::scale::Area<int32_t,dimensions> dst_area, cc0::scale::Area<fixed_t,dimensions> src_area, const processor_t &processor, cc0::scale::Area<int32_t,dimensions> dst_mask)
+{
+	execute_exact(ExactPlan<dimensions,fixed_t>(dst_area, src_area, dst_mask), processor);
+}
+
+template < typename processor_t, uint32_t dimensions, typename fixed_t >
+uint32_t cc0::scale::scale_batch(const cc0::scale::Area<int32_t,dimensions> *dst_areas, const cc0::scale::Area<fixed_t,dimensions> *src_areas, uint32_t count, const processor_t &processor, cc0::scale::Area<int32_t,dimensions> dst_mask, cc0::scale::ScalePlan<dimensions,fixed_t> *plans)
+{
+	// Planned and executed a chunk at a time, so that the plans of a chunk are still in cache when they are executed.
+	static constexpr uint32_t CHUNK = 64;
+	uint32_t n = 0;
+	for (uint32_t first = 0; first < count; first += CHUNK) {
+		const uint32_t m = plan_batch(dst_areas + first, src_areas + first, internal::min(count - first, CHUNK), dst_mask, plans + n);
+		execute_batch(plans + n, m, processor);
+		n += m;
+	}
+	return n;
+}
+
+template < uint32_t dimensions, typename fixed_t >
+bool cc0::scale::bin_batch(cc0::scale::TileBins<dimensions,fixed_t> &bins, const cc0::scale::Area<int32_t,dimensions> *dst_areas, const cc0::scale::Area<fixed_t,dimensions> *src_areas, uint32_t count, cc0::scale::Area<int32_t,dimensions> dst_mask, int32_t tile_size, cc0::scale::ScalePlan<dimensions,fixed_t> *plans, uint32_t *offsets, uint32_t offset_capacity, uint32_t *entries, uint32_t entry_capacity)
+{
+	bins = TileBins<dimensions,fixed_t>();
+	if (tile_size <= 0) { return false; }
+	for (uint32_t i = 0; i < dimensions; ++i) {
+		if (dst_mask.a[i] > dst_mask.b[i]) { internal::swap(dst_mask.a[i], dst_mask.b[i]); }
+	}
+	const uint64_t tiles = TileBins<dimensions,fixed_t>::tile_count(dst_mask, tile_size);
+	if (tiles > TileBins<dimensions,fixed_t>::MAX_TILES || offsets == nullptr || uint64_t(offset_capacity) < tiles + 1) { return false; }
+	if (plans == nullptr && count > 0) { return false; }
+
+	const uint32_t tile_count = uint32_t(tiles);
+	TileBins<dimensions,fixed_t> result;
+	result.mask = dst_mask;
+	result.size = tile_size;
+	result.count = tile_count;
+	for (uint32_t i = 0; i < dimensions; ++i) {
+		result.tiles[i] = int32_t((int64_t(dst_mask.b[i]) - dst_mask.a[i] + tile_size - 1) / tile_size);
+	}
+	for (uint32_t i = 0; i <= tile_count; ++i) {
+		offsets[i] = 0;
+	}
+	// Tiles are counted from the areas rather than the plans, so that the plans are only written once the entries are known to fit.
+	for (uint32_t i = 0; i < count; ++i) {
+		if (internal::cull(dst_areas[i], src_areas[i], dst_mask) == skip_reason::none) {
+			internal::for_each_tile(result, dst_areas[i], internal::count_tile{ offsets });
+		}
+	}
+	uint64_t total = 0;
+	for (uint32_t i = 1; i <= tile_count; ++i) {
+		total += offsets[i];
+		if (total > entry_capacity) { return false; }
+		offsets[i] = uint32_t(total);
+	}
+	if (entries == nullptr && total > 0) { return false; }
+	const uint32_t n = plan_batch(dst_areas, src_areas, count, dst_mask, plans);
+	for (uint32_t i = 0; i < n; ++i) {
+		internal::for_each_tile(result, plans[i].dst_area, internal::fill_tile{ offsets, entries, i });
+	}
+	// Filling advanced every offset to the start of the next tile.
+	for (uint32_t i = tile_count; i > 0; --i) {
+		offsets[i] = offsets[i - 1];
+	}
+	offsets[0] = 0;
+	result.offsets = offsets;
+	result.entries = entries;
+	result.plans = plans;
+	bins = result;
+	return true;
+}
+
+template < typename processor_t, uint32_t dimensions, typename fixed_t, typename executor_t >
+void cc0::scale::scale_binned(const cc0::scale::TileBins<dimensions,fixed_t> &bins, const processor_t &processor, const executor_t &executor)
+{
+	if (bins.count > 0 && bins.offsets != nullptr) {
+		executor(bins.count, internal::binned_task<processor_t,dimensions,fixed_t>(bins, processor));
+	}
+}
+
+template < typename processor_t, uint32_t dimensions, typename fixed_t >
+bool cc0::scale::tabulate(cc0::scale::ScalePlan<dimensions,fixed_t> &plan, const processor_t &processor, int32_t *index, float *weight, int32_t capacity)
+{
+	if (plan.empty) { return true; }
+	const int32_t count = plan.dst_area.b[0] - plan.dst_area.a[0];
+	if (index == nullptr || count > capacity || !processor.tabulate(plan.src_start[0], plan.src_delta[0], count, index, weight)) { return false; }
+	plan.index = index;
+	plan.weight = weight;
+	return true;
+}
+
+template < typename dst_area_t, typename src_area_t, typename dst_mask_t, typename processor_t >
+void cc0::scale::scale(const processor_t &processor)
+{
+	internal::static_scale<internal::static_plan<dst_area_t,src_area_t,dst_mask_t>,processor_t>::run(processor);
+}
+
+template < typename filter_t, typename dst_t, typename src_t >
+bool cc0::scale::scale_separable(cc0::scale::Area<int32_t,2> dst_area, cc0::scale::Area<fixed32_t,2> src_area, const cc0::scale::separable<filter_t,dst_t,src_t> &engine, cc0::scale::Area<int32_t,2> dst_mask)
+{
+	const int32_t width = dst_area.b[0] - dst_area.a[0];
+	if ((width < 0 ? -width : width) > engine.ring_width() || separable<filter_t,dst_t,src_t>::rows(dst_area, src_area) > engine.ring_rows()) {
+		return false;
+	}
+	scale(dst_area, src_area, internal::no_processor<2>(), dst_mask, internal::separable_pass< separable<filter_t,dst_t,src_t> >(engine));
+	return true;
+}
+
+template < typename processor_t, uint32_t dimensions, typename fixed_t, typename executor_t >
+void cc0::scale::scale_parallel(cc0::scale::Area<int32_t,dimensions> dst_area, cc0::scale::Area<fixed_t,dimensions> src_area, const processor_t &processor, cc0::scale::Area<int32_t,dimensions> dst_mask, const executor_t &executor)
+{
+	Area<int32_t,dimensions> clipped;
+	if (!internal::clip(dst_area, dst_mask, clipped)) {
+		scale(dst_area, src_area, processor, dst_mask); // Reports why nothing was processed.
+		return;
+	}
+	const uint32_t count = internal::min(executor.size(), uint32_t(clipped.b[dimensions - 1] - clipped.a[dimensions - 1]));
+	if (count <= 1) {
+		scale(dst_area, src_area, processor, clipped);
+		return;
+	}
+	executor(count, internal::parallel_task<processor_t,dimensions,fixed_t>(dst_area, src_area, processor, clipped, count));
+}
+
+template < typename dst_t, typename src_t, uint32_t dimensions >
+bool cc0::scale::build_pyramid(const src_t *src, const cc0::scale::Point<int32_t,dimensions> &src_stride, const cc0::scale::Point<int32_t,dimensions> &src_size, const cc0::scale::PyramidLevel<dst_t,dimensions> *levels, uint32_t count)
+{
+	if (count > MAX_PYRAMID_LEVELS) { return false; }
+	for (uint32_t i = 0; i < dimensions; ++i) {
+		if (src_size[i] <= 0) { return false; }
+		for (uint32_t l = 0; l < count; ++l) {
+			if (levels[l].size[i] <= 0) { return false; }
+		}
+	}
+	if (count == 0) { return true; }
+	const uint32_t outer = dimensions - 1;
+	int32_t done[MAX_PYRAMID_LEVELS] = { 0 }; // The number of slices along the outermost axis produced for each level.
+	while (done[0] < levels[0].size[outer]) {
+		internal::pyramid_slice(levels[0], src, src_stride, src_size, done[0]++);
+		// Produce every slice of the smaller levels that is now covered, while the slices it reads are still in the cache.
+		for (uint32_t l = 1; l < count; ++l) {
+			const PyramidLevel<dst_t,dimensions> &level = levels[l], &above = levels[l - 1];
+			while (done[l] < level.size[outer] && internal::pyramid_needs(level.size[outer], above.size[outer], done[l]) <= done[l - 1]) {
+				internal::pyramid_slice(level, static_cast<const dst_t*>(above.data), above.stride, above.size, done[l]++);
+			}
 		}
 	}
-	Point<int32_t,dimensions> dst_index;
-	Point<fixed32_t,dimensions> src_index;
-	internal::iterator<dimensions-1,dimensions,processor_t>{}(dst_index, src_index, dst_area, src_start, src_delta, processor);
+	return true;
 }
 
 #endif
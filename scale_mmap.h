@@ -0,0 +1,191 @@
+/// @file scale_mmap.h
+/// @brief Optional support for scaling memory-mapped files. Unlike scale.h this header depends on POSIX for memory mapping and paging hints.
+/// @author github.com/SirJonthe
+/// @date 2025
+/// @copyright Public domain.
+/// @license CC0 1.0
+
+#ifndef CC0_SCALE_MMAP_H__
+#define CC0_SCALE_MMAP_H__
+
+#include <cstddef>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "scale.h"
+
+namespace cc0
+{
+	namespace scale
+	{
+		/// @brief A file mapped into memory, unmapped when destroyed.
+		class mapped_file
+		{
+		private:
+			void   *m_data; // The mapped memory, or null.
+			size_t  m_size; // The number of mapped bytes.
+
+		public:
+			/// @brief Maps an existing file for reading.
+			/// @param path The path of the file.
+			explicit mapped_file(const char *path) : m_data(nullptr), m_size(0)
+			{
+				const int fd = ::open(path, O_RDONLY);
+				if (fd < 0) { return; }
+				struct stat info;
+				if (::fstat(fd, &info) == 0 && info.st_size > 0) {
+					void *data = ::mmap(nullptr, size_t(info.st_size), PROT_READ, MAP_SHARED, fd, 0);
+					if (data != MAP_FAILED) {
+						m_data = data;
+						m_size = size_t(info.st_size);
+					}
+				}
+				::close(fd);
+			}
+
+			/// @brief Creates, or truncates, a file of a given size and maps it for reading and writing.
+			/// @param path The path of the file.
+			/// @param size The size of the file in bytes.
+			mapped_file(const char *path, size_t size) : m_data(nullptr), m_size(0)
+			{
+				const int fd = ::open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+				if (fd < 0) { return; }
+				if (size > 0 && ::ftruncate(fd, off_t(size)) == 0) {
+					void *data = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+					if (data != MAP_FAILED) {
+						m_data = data;
+						m_size = size;
+					}
+				}
+				::close(fd);
+			}
+
+			mapped_file(const mapped_file&) = delete;
+			mapped_file &operator=(const mapped_file&) = delete;
+
+			/// @brief Unmaps the file. Changes to writable mappings are written back to the file by the operating system.
+			~mapped_file( void )
+			{
+				if (m_data != nullptr) { ::munmap(m_data, m_size); }
+			}
+
+			/// @brief Returns the mapped memory.
+			/// @return The mapped memory, or null if the file could not be mapped.
+			void *data( void ) const { return m_data; }
+
+			/// @brief Returns the size of the mapping.
+			/// @return The number of mapped bytes.
+			size_t size( void ) const { return m_size; }
+
+			/// @brief Tells the operating system that the mapping will be accessed sequentially, e.g. a destination visited in row-major order, so it can read ahead aggressively and drop pages after use.
+			void sequential( void ) const
+			{
+				if (m_data != nullptr) { ::madvise(m_data, m_size, MADV_SEQUENTIAL); }
+			}
+
+			/// @brief Starts writing changes to the file without waiting for them to complete.
+			void flush( void ) const
+			{
+				if (m_data != nullptr) { ::msync(m_data, m_size, MS_ASYNC); }
+			}
+		};
+
+		/// @brief A reader for the streamed traversal policy that pages in a memory-mapped source as it is scaled. Source rows, i.e. slices along the outermost axis, that are about to be read are requested ahead of time with MADV_WILLNEED, and rows that have been passed are released with MADV_DONTNEED, so that the access pattern known by the traversal turns into sequential reads rather than page faults.
+		/// @note Releasing rows of a file mapping only drops them from the address space. They are read back from the file if accessed again.
+		/// @sa streamed
+		class mapped_rows
+		{
+		private:
+			const char      *m_base;      // The first byte of the first source row.
+			size_t           m_row_bytes; // The number of bytes between two adjacent source rows.
+			int32_t          m_rows;      // The number of source rows.
+			int32_t          m_lookahead; // The number of rows to request ahead of the rows in use.
+			size_t           m_page;      // The size of a memory page.
+			mutable int32_t  m_first;     // The first row in use.
+			mutable int32_t  m_last;      // The last row in use, less than m_first if there are none.
+			mutable int32_t  m_ahead;     // The row up to which rows have been requested, in the direction of travel.
+			mutable size_t   m_released;  // The address up to which pages have been released, in the direction of travel.
+			mutable bool     m_reverse;   // Determines if the rows are being visited from the last to the first.
+
+		private:
+			/// @brief Returns the address of the start of a row.
+			/// @param row The row. Clamped to the rows of the source.
+			/// @return The address.
+			size_t address(int32_t row) const
+			{
+				row = row > 0 ? (row < m_rows ? row : m_rows) : 0;
+				return size_t(reinterpret_cast<uintptr_t>(m_base)) + size_t(row) * m_row_bytes;
+			}
+
+			/// @brief Gives a paging hint for a range of whole pages.
+			/// @param a The start address. Must be aligned to a page.
+			/// @param b The end address.
+			/// @param advice The hint.
+			static void advise(size_t a, size_t b, int advice)
+			{
+				if (a < b) {
+					::madvise(reinterpret_cast<void*>(a), b - a, advice);
+				}
+			}
+
+			/// @brief Requests a range of rows.
+			/// @param first The first row.
+			/// @param last The last row, inclusive.
+			void request(int32_t first, int32_t last) const
+			{
+				advise(address(first) / m_page * m_page, address(last + 1), MADV_WILLNEED);
+			}
+
+		public:
+			/// @brief Creates a new reader.
+			/// @param base The first byte of the first source row in the mapping.
+			/// @param row_bytes The number of bytes between two adjacent source rows.
+			/// @param rows The number of source rows.
+			/// @param lookahead The number of rows to request ahead of the rows in use.
+			mapped_rows(const void *base, size_t row_bytes, int32_t rows, int32_t lookahead = 16) : m_base(static_cast<const char*>(base)), m_row_bytes(row_bytes), m_rows(rows), m_lookahead(lookahead > 0 ? lookahead : 1), m_page(size_t(::sysconf(_SC_PAGESIZE))), m_first(0), m_last(-1), m_ahead(0), m_released(0), m_reverse(false) {}
+
+			/// @brief Requests upcoming rows and releases the rows no longer in use.
+			/// @param first The first row needed next.
+			/// @param last The last row needed next, inclusive.
+			void operator()(int32_t first, int32_t last) const
+			{
+				const bool started = m_first <= m_last;
+				const bool reverse = started && (first < m_first || (first == m_first && last < m_last));
+				if (!started || reverse != m_reverse) {
+					m_reverse = reverse;
+					m_ahead = reverse ? last + 1 : first - 1;
+					m_released = reverse ? (address(last + 1) + m_page - 1) / m_page * m_page : address(first) / m_page * m_page;
+				}
+				// Only release whole pages, since the pages at the ends of the range may still contain rows in use.
+				if (!reverse) {
+					const size_t end = address(first) / m_page * m_page;
+					if (end > m_released) {
+						advise(m_released, end, MADV_DONTNEED);
+						m_released = end;
+					}
+				} else {
+					const size_t start = (address(last + 1) + m_page - 1) / m_page * m_page;
+					if (start < m_released) {
+						advise(start, m_released, MADV_DONTNEED);
+						m_released = start;
+					}
+				}
+				// Request rows in batches once less than half of the lookahead remains.
+				if (!reverse && m_ahead < last + m_lookahead / 2) {
+					const int32_t from = m_ahead + 1 > first ? m_ahead + 1 : first;
+					m_ahead = last + m_lookahead;
+					request(from, m_ahead);
+				} else if (reverse && m_ahead > first - m_lookahead / 2) {
+					const int32_t to = m_ahead - 1 < last ? m_ahead - 1 : last;
+					m_ahead = first - m_lookahead;
+					request(m_ahead, to);
+				}
+				m_first = first;
+				m_last = last;
+			}
+		};
+	}
+}
+
+#endif
@@ -0,0 +1,339 @@
+/// @file scale_opencl.h
+/// @brief Optional support for scaling arrays in OpenCL device buffers. Unlike scale.h this header depends on OpenCL 1.2 or above.
+/// @author github.com/SirJonthe
+/// @date 2025
+/// @copyright Public domain.
+/// @license CC0 1.0
+
+#ifndef CC0_SCALE_OPENCL_H__
+#define CC0_SCALE_OPENCL_H__
+
+#include <cstdio>
+#if defined(__APPLE__)
+	#include <OpenCL/opencl.h>
+#else
+	#ifndef CL_TARGET_OPENCL_VERSION
+		#define CL_TARGET_OPENCL_VERSION 120
+	#endif
+	#include <CL/cl.h>
+#endif
+#include "scale.h"
+
+namespace cc0
+{
+	namespace scale
+	{
+		namespace internal
+		{
+			/// @brief The name of the OpenCL C type matching an element type. Only defined for types that have one.
+			/// @tparam type_t The element type.
+			template < typename type_t >
+			struct opencl_type;
+
+			template <> struct opencl_type<int8_t>   { static const char *name( void ) { return "char"; } };
+			template <> struct opencl_type<uint8_t>  { static const char *name( void ) { return "uchar"; } };
+			template <> struct opencl_type<int16_t>  { static const char *name( void ) { return "short"; } };
+			template <> struct opencl_type<uint16_t> { static const char *name( void ) { return "ushort"; } };
+			template <> struct opencl_type<int32_t>  { static const char *name( void ) { return "int"; } };
+			template <> struct opencl_type<uint32_t> { static const char *name( void ) { return "uint"; } };
+			template <> struct opencl_type<float>    { static const char *name( void ) { return "float"; } };
+
+			/// @brief Returns the source of the kernels. One work item is run per element of the clipped destination area, and computes the same source index as the iterators with the same wrapping integer arithmetic, so that results match write and write_linear.
+			/// @return The source, to be built with DST, SRC, and DIMS defined, ONE and MASK defined as in linear_taps, and ROUND defined as 1 if DST is not a floating-point type.
+			inline const char *opencl_source( void )
+			{
+				return R"CL(
+#pragma OPENCL FP_CONTRACT OFF
+
+#define CORNERS (1 << (DIMS - 1))
+
+// The bits of the source index of the k-th element along an axis, wrapping like the iterators stepping from start by delta.
+int source_bits(int start, int delta, int k)
+{
+	return as_int((uint)start + (uint)delta * (uint)k);
+}
+
+int clamp_index(int i, int size)
+{
+	return i < 0 ? 0 : (i >= size ? size - 1 : i);
+}
+
+DST filtered(float v)
+{
+#if ROUND
+	return (DST)(v < 0.0f ? v - 0.5f : v + 0.5f);
+#else
+	return (DST)v;
+#endif
+}
+
+__kernel void scale_nearest(__global DST *dst, int4 dst_stride, __global const SRC *src, int4 src_stride, int4 dst_a, int4 src_start, int4 src_delta)
+{
+	const int k[3]      = { (int)get_global_id(0), (int)get_global_id(1), (int)get_global_id(2) };
+	const int a[3]      = { dst_a.x, dst_a.y, dst_a.z };
+	const int start[3]  = { src_start.x, src_start.y, src_start.z };
+	const int delta[3]  = { src_delta.x, src_delta.y, src_delta.z };
+	const int dstep[3]  = { dst_stride.x, dst_stride.y, dst_stride.z };
+	const int sstep[3]  = { src_stride.x, src_stride.y, src_stride.z };
+	int out = 0;
+	int in  = 0;
+	for (int i = 0; i < DIMS; ++i) {
+		out += (a[i] + k[i]) * dstep[i];
+		in  += (source_bits(start[i], delta[i], k[i]) >> 15) * sstep[i];
+	}
+	dst[out] = (DST)src[in];
+}
+
+// src_center holds the source starts already moved to the centers of the elements by linear_taps::center on the host.
+__kernel void scale_linear(__global DST *dst, int4 dst_stride, __global const SRC *src, int4 src_stride, int4 src_size, int4 dst_a, int4 src_center, int4 src_delta)
+{
+	const int k[3]      = { (int)get_global_id(0), (int)get_global_id(1), (int)get_global_id(2) };
+	const int a[3]      = { dst_a.x, dst_a.y, dst_a.z };
+	const int start[3]  = { src_center.x, src_center.y, src_center.z };
+	const int delta[3]  = { src_delta.x, src_delta.y, src_delta.z };
+	const int dstep[3]  = { dst_stride.x, dst_stride.y, dst_stride.z };
+	const int sstep[3]  = { src_stride.x, src_stride.y, src_stride.z };
+	const int size[3]   = { src_size.x, src_size.y, src_size.z };
+	int   offset[CORNERS];
+	float weight[CORNERS];
+	offset[0] = 0;
+	weight[0] = 1.0f;
+	int corners = 1;
+	for (int i = 1; i < DIMS; ++i) {
+		const int   x  = source_bits(start[i], delta[i], k[i]);
+		const float f  = (float)(x & MASK) * (1.0f / ONE);
+		const int   o0 = clamp_index(x >> 15, size[i]) * sstep[i];
+		const int   o1 = clamp_index((x >> 15) + 1, size[i]) * sstep[i];
+		for (int c = 0; c < corners; ++c) {
+			offset[c + corners] = offset[c] + o1;
+			weight[c + corners] = weight[c] * f;
+			offset[c] += o0;
+			weight[c] *= 1.0f - f;
+		}
+		corners *= 2;
+	}
+	int out = 0;
+	for (int i = 0; i < DIMS; ++i) {
+		out += (a[i] + k[i]) * dstep[i];
+	}
+	const int   x  = source_bits(start[0], delta[0], k[0]);
+	const float f  = (float)(x & MASK) * (1.0f / ONE);
+	const int   i0 = clamp_index(x >> 15, size[0]) * sstep[0];
+	const int   i1 = clamp_index((x >> 15) + 1, size[0]) * sstep[0];
+	float sum = 0.0f;
+	for (int c = 0; c < CORNERS; ++c) {
+		__global const SRC *in = src + offset[c];
+		sum += weight[c] * ((float)in[i0] + ((float)in[i1] - (float)in[i0]) * f);
+	}
+	dst[out] = filtered(sum);
+}
+)CL";
+			}
+		}
+
+		/// @brief Executes the nearest and linear writes of scale.h on arrays in OpenCL device buffers, described by the same destination and source areas, destination masks, and plans as on the host. The plan is computed on the host and every element of the clipped destination area is then written by one work item, so bulk rescales can be moved off of the CPU without describing the geometry any differently.
+		/// @tparam dst_t The type of the destination elements.
+		/// @tparam src_t The type of the source elements.
+		/// @tparam dimensions The number of dimensions of the arrays. At most 3.
+		/// @note Only the geometry of a plan is used. Tables set by tabulate are ignored.
+		/// @note Writes are enqueued without waiting for them to complete. The arrays must not be changed on the host until they have.
+		/// @note Setting up a write changes the arguments of a shared kernel, so a scaler must not be used by several threads at once.
+		/// @sa write
+		/// @sa write_linear
+		template < typename dst_t, typename src_t = dst_t, uint32_t dimensions = 1 >
+		class opencl_scaler
+		{
+		private:
+			static_assert(dimensions >= 1 && dimensions <= 3, "OpenCL supports at most 3 dimensions of work items.");
+
+			cl_command_queue m_queue;   // The queue writes are enqueued on.
+			cl_program       m_program; // The program containing the kernels, or null.
+			cl_kernel        m_nearest; // The kernel of write, or null.
+			cl_kernel        m_linear;  // The kernel of write_linear, or null.
+			cl_int           m_status;  // The error, if any, produced while setting up the kernels.
+
+		private:
+			/// @brief Packs the components of a point into an OpenCL vector, filling unused components with zero.
+			/// @param p The point.
+			/// @return The vector.
+			static cl_int4 pack(const Point<int32_t,dimensions> &p)
+			{
+				cl_int4 v;
+				for (uint32_t i = 0; i < 4; ++i) {
+					v.s[i] = i < dimensions ? p[i] : 0;
+				}
+				return v;
+			}
+
+			/// @brief Packs the bit patterns of the components of a point into an OpenCL vector, filling unused components with zero.
+			/// @param p The point.
+			/// @return The vector.
+			static cl_int4 pack(const Point<fixed32_t,dimensions> &p)
+			{
+				cl_int4 v;
+				for (uint32_t i = 0; i < 4; ++i) {
+					v.s[i] = i < dimensions ? p[i].value_bits : 0;
+				}
+				return v;
+			}
+
+			/// @brief Sets the arguments describing the geometry of a plan and enqueues a kernel over its clipped destination area.
+			/// @param kernel The kernel, with all arguments except the geometry already set.
+			/// @param first The index of the first argument describing the geometry.
+			/// @param plan The plan.
+			/// @param center Whether to move the source start to the centers of the elements, as write_linear samples.
+			/// @param event Optionally receives an event signaled when the write has completed. Set to null if nothing was enqueued.
+			/// @return CL_SUCCESS, or the error produced by OpenCL.
+			cl_int enqueue(cl_kernel kernel, cl_uint first, const ScalePlan<dimensions> &plan, bool center, cl_event *event)
+			{
+				if (event != nullptr) { *event = nullptr; }
+				if (plan.empty) {
+					internal::instrumentation::skipped(plan.reason);
+					return CL_SUCCESS;
+				}
+				const cl_int4 dst_a     = pack(plan.dst_area.a);
+				cl_int4 src_start = pack(plan.src_start);
+				if (center) {
+					for (uint32_t i = 0; i < dimensions; ++i) {
+						src_start.s[i] = internal::linear_taps::center(plan.src_start[i], plan.src_delta[i]);
+					}
+				}
+				const cl_int4 src_delta = pack(plan.src_delta);
+				cl_int status = clSetKernelArg(kernel, first, sizeof(dst_a), &dst_a);
+				if (status == CL_SUCCESS) { status = clSetKernelArg(kernel, first + 1, sizeof(src_start), &src_start); }
+				if (status == CL_SUCCESS) { status = clSetKernelArg(kernel, first + 2, sizeof(src_delta), &src_delta); }
+				if (status != CL_SUCCESS) { return status; }
+				size_t global[dimensions];
+				for (uint32_t i = 0; i < dimensions; ++i) {
+					global[i] = size_t(plan.dst_area.b[i] - plan.dst_area.a[i]);
+				}
+				return clEnqueueNDRangeKernel(m_queue, kernel, dimensions, nullptr, global, nullptr, 0, nullptr, event);
+			}
+
+			/// @brief Sets the arguments describing the arrays of a kernel.
+			/// @param kernel The kernel.
+			/// @param dst The destination buffer.
+			/// @param dst_stride The number of destination elements between two adjacent indices on each axis.
+			/// @param src The source buffer.
+			/// @param src_stride The number of source elements between two adjacent indices on each axis.
+			/// @return CL_SUCCESS, or the error produced by OpenCL.
+			static cl_int arrays(cl_kernel kernel, cl_mem dst, const Point<int32_t,dimensions> &dst_stride, cl_mem src, const Point<int32_t,dimensions> &src_stride)
+			{
+				const cl_int4 dst_step = pack(dst_stride);
+				const cl_int4 src_step = pack(src_stride);
+				cl_int status = clSetKernelArg(kernel, 0, sizeof(dst), &dst);
+				if (status == CL_SUCCESS) { status = clSetKernelArg(kernel, 1, sizeof(dst_step), &dst_step); }
+				if (status == CL_SUCCESS) { status = clSetKernelArg(kernel, 2, sizeof(src), &src); }
+				if (status == CL_SUCCESS) { status = clSetKernelArg(kernel, 3, sizeof(src_step), &src_step); }
+				return status;
+			}
+
+		public:
+			/// @brief Builds the kernels for a device.
+			/// @param context The context the buffers belong to.
+			/// @param device The device to build the kernels for.
+			/// @param queue The queue to enqueue writes on. Retained until the scaler is destroyed.
+			/// @note Check status before use, since building can fail.
+			opencl_scaler(cl_context context, cl_device_id device, cl_command_queue queue) : m_queue(queue), m_program(nullptr), m_nearest(nullptr), m_linear(nullptr), m_status(CL_SUCCESS)
+			{
+				clRetainCommandQueue(m_queue);
+				const char *source = internal::opencl_source();
+				m_program = clCreateProgramWithSource(context, 1, &source, nullptr, &m_status);
+				if (m_status != CL_SUCCESS) { return; }
+				char options[160];
+				std::snprintf(options, sizeof(options), "-D DST=%s -D SRC=%s -D DIMS=%u -D ONE=%d -D MASK=%d -D ROUND=%d", internal::opencl_type<dst_t>::name(), internal::opencl_type<src_t>::name(), unsigned(dimensions), int(internal::linear_taps::ONE), int(internal::linear_taps::MASK), internal::is_same<dst_t,float>::value ? 0 : 1);
+				m_status = clBuildProgram(m_program, 1, &device, options, nullptr, nullptr);
+				if (m_status != CL_SUCCESS) { return; }
+				m_nearest = clCreateKernel(m_program, "scale_nearest", &m_status);
+				if (m_status != CL_SUCCESS) { return; }
+				m_linear = clCreateKernel(m_program, "scale_linear", &m_status);
+			}
+
+			opencl_scaler(const opencl_scaler&) = delete;
+			opencl_scaler &operator=(const opencl_scaler&) = delete;
+
+			/// @brief Releases the kernels and the queue. Does not wait for enqueued writes.
+			~opencl_scaler( void )
+			{
+				if (m_linear != nullptr) { clReleaseKernel(m_linear); }
+				if (m_nearest != nullptr) { clReleaseKernel(m_nearest); }
+				if (m_program != nullptr) { clReleaseProgram(m_program); }
+				clReleaseCommandQueue(m_queue);
+			}
+
+			/// @brief Returns the error, if any, produced while building the kernels.
+			/// @return CL_SUCCESS if the scaler can be used.
+			cl_int status( void ) const { return m_status; }
+
+			/// @brief Returns the program containing the kernels, e.g. to retrieve the build log after a failed build.
+			/// @return The program, or null if it could not be created.
+			cl_program program( void ) const { return m_program; }
+
+			/// @brief Copies the nearest source element to every element of the clipped destination area of a plan, writing the same elements as write.
+			/// @param plan The plan.
+			/// @param dst The destination buffer.
+			/// @param dst_stride The number of destination elements between two adjacent indices on each axis.
+			/// @param src The source buffer.
+			/// @param src_stride The number of source elements between two adjacent indices on each axis.
+			/// @param event Optionally receives an event signaled when the write has completed. Set to null if nothing was enqueued.
+			/// @return CL_SUCCESS, or the error produced by OpenCL.
+			cl_int write(const ScalePlan<dimensions> &plan, cl_mem dst, const Point<int32_t,dimensions> &dst_stride, cl_mem src, const Point<int32_t,dimensions> &src_stride, cl_event *event = nullptr)
+			{
+				if (m_status != CL_SUCCESS) { return m_status; }
+				const cl_int status = arrays(m_nearest, dst, dst_stride, src, src_stride);
+				return status == CL_SUCCESS ? enqueue(m_nearest, 4, plan, false, event) : status;
+			}
+
+			/// @brief Copies the nearest source element to every element of a destination area, writing the same elements as scale with write.
+			/// @param dst_area The destination area to scale the source area over.
+			/// @param src_area The source area to scale over the destination area.
+			/// @param dst_mask A mask used to discard all processing on the destination buffer that falls outside of the area.
+			/// @param dst The destination buffer.
+			/// @param dst_stride The number of destination elements between two adjacent indices on each axis.
+			/// @param src The source buffer.
+			/// @param src_stride The number of source elements between two adjacent indices on each axis.
+			/// @param event Optionally receives an event signaled when the write has completed. Set to null if nothing was enqueued.
+			/// @return CL_SUCCESS, or the error produced by OpenCL.
+			cl_int write(const Area<int32_t,dimensions> &dst_area, const Area<fixed32_t,dimensions> &src_area, const Area<int32_t,dimensions> &dst_mask, cl_mem dst, const Point<int32_t,dimensions> &dst_stride, cl_mem src, const Point<int32_t,dimensions> &src_stride, cl_event *event = nullptr)
+			{
+				return write(ScalePlan<dimensions>(dst_area, src_area, dst_mask), dst, dst_stride, src, src_stride, event);
+			}
+
+			/// @brief Interpolates linearly between the source elements nearest to the center of every element of the clipped destination area of a plan, writing the same elements as write_linear up to floating-point rounding on the device.
+			/// @param plan The plan.
+			/// @param dst The destination buffer.
+			/// @param dst_stride The number of destination elements between two adjacent indices on each axis.
+			/// @param src The source buffer.
+			/// @param src_stride The number of source elements between two adjacent indices on each axis.
+			/// @param src_size The number of source elements along each axis. Source indices are clamped to these bounds.
+			/// @param event Optionally receives an event signaled when the write has completed. Set to null if nothing was enqueued.
+			/// @return CL_SUCCESS, or the error produced by OpenCL.
+			cl_int write_linear(const ScalePlan<dimensions> &plan, cl_mem dst, const Point<int32_t,dimensions> &dst_stride, cl_mem src, const Point<int32_t,dimensions> &src_stride, const Point<int32_t,dimensions> &src_size, cl_event *event = nullptr)
+			{
+				if (m_status != CL_SUCCESS) { return m_status; }
+				const cl_int4 size = pack(src_size);
+				cl_int status = arrays(m_linear, dst, dst_stride, src, src_stride);
+				if (status == CL_SUCCESS) { status = clSetKernelArg(m_linear, 4, sizeof(size), &size); }
+				return status == CL_SUCCESS ? enqueue(m_linear, 5, plan, true, event) : status;
+			}
+
+			/// @brief Interpolates linearly between the source elements nearest to the center of every element of a destination area, writing the same elements as scale with write_linear up to floating-point rounding on the device.
+			/// @param dst_area The destination area to scale the source area over.
+			/// @param src_area The source area to scale over the destination area.
+			/// @param dst_mask A mask used to discard all processing on the destination buffer that falls outside of the area.
+			/// @param dst The destination buffer.
+			/// @param dst_stride The number of destination elements between two adjacent indices on each axis.
+			/// @param src The source buffer.
+			/// @param src_stride The number of source elements between two adjacent indices on each axis.
+			/// @param src_size The number of source elements along each axis. Source indices are clamped to these bounds.
+			/// @param event Optionally receives an event signaled when the write has completed. Set to null if nothing was enqueued.
+			/// @return CL_SUCCESS, or the error produced by OpenCL.
+			cl_int write_linear(const Area<int32_t,dimensions> &dst_area, const Area<fixed32_t,dimensions> &src_area, const Area<int32_t,dimensions> &dst_mask, cl_mem dst, const Point<int32_t,dimensions> &dst_stride, cl_mem src, const Point<int32_t,dimensions> &src_stride, const Point<int32_t,dimensions> &src_size, cl_event *event = nullptr)
+			{
+				return write_linear(ScalePlan<dimensions>(dst_area, src_area, dst_mask), dst, dst_stride, src, src_stride, src_size, event);
+			}
+		};
+	}
+}
+
+#endif
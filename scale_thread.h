@@ -0,0 +1,676 @@
+/// @file scale_thread.h
+/// @brief Optional multi-threading support for scale. Unlike scale.h this header depends on the standard library for threads and synchronization.
+/// @author github.com/SirJonthe
+/// @date 2025
+/// @copyright Public domain.
+/// @license CC0 1.0
+
+#ifndef CC0_SCALE_THREAD_H__
+#define CC0_SCALE_THREAD_H__
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "scale.h"
+
+namespace cc0
+{
+	namespace scale
+	{
+		/// @brief A small pool of worker threads that can be used as an executor for scale_parallel.
+		/// @note The thread calling the pool also processes tasks while waiting for them to complete.
+		class thread_pool
+		{
+		private:
+			/// @brief A set of tasks submitted to the pool.
+			struct job
+			{
+				void       (*run)(const void*, uint32_t); // Runs a single task.
+				const void  *task;                        // The task function/functor.
+				uint32_t     count;                       // The number of tasks.
+				uint32_t     next;                        // The index of the next task to hand out.
+				uint32_t     remaining;                   // The number of tasks not yet completed.
+				job         *link;                        // The next job in the queue.
+				void       (*release)(job*);              // Destroys a job submitted without waiting for it. Null for jobs owned by a waiting caller.
+			};
+
+			/// @brief A job that owns a copy of its task, submitted without waiting for it to complete.
+			/// @tparam task_t The type of the task function/functor.
+			template < typename task_t >
+			struct detached_job : job
+			{
+				task_t copy; // The task function/functor.
+
+				/// @brief Creates a new job.
+				/// @param count The number of tasks.
+				/// @param task The task function/functor to copy.
+				detached_job(uint32_t count, const task_t &task) : job(job{ &thread_pool::invoke<task_t>, &copy, count, 0, count, nullptr, &thread_pool::destroy<task_t> }), copy(task) {}
+			};
+
+		private:
+			mutable std::mutex              m_mutex;   // Guards all members below.
+			mutable std::condition_variable m_wake;    // Signals workers that there are tasks to process.
+			mutable std::condition_variable m_done;    // Signals callers that a job has completed.
+			mutable job                    *m_head;    // The first job in the queue with tasks left to hand out.
+			bool                            m_quit;    // Signals workers to exit.
+			std::vector<std::thread>        m_threads; // The worker threads.
+
+		private:
+			/// @brief Runs a single task in a type-erased job.
+			/// @tparam task_t The type of the task function/functor.
+			/// @param task The task function/functor.
+			/// @param i The index of the task.
+			template < typename task_t >
+			static void invoke(const void *task, uint32_t i)
+			{
+				(*static_cast<const task_t*>(task))(i);
+			}
+
+			/// @brief Destroys a detached job once all of its tasks have completed.
+			/// @tparam task_t The type of the task function/functor.
+			/// @param j The job.
+			template < typename task_t >
+			static void destroy(job *j)
+			{
+				delete static_cast<detached_job<task_t>*>(j);
+			}
+
+			/// @brief Adds a job to the end of the queue and wakes up the workers. The lock must be held.
+			/// @param j The job.
+			void push(job *j) const
+			{
+				job **tail = &m_head;
+				while (*tail != nullptr) { tail = &(*tail)->link; }
+				*tail = j;
+				m_wake.notify_all();
+			}
+
+			/// @brief Removes a job from the queue. The lock must be held.
+			/// @param j The job to remove.
+			void unlink(job *j) const
+			{
+				for (job **p = &m_head; *p != nullptr; p = &(*p)->link) {
+					if (*p == j) {
+						*p = j->link;
+						return;
+					}
+				}
+			}
+
+			/// @brief Hands out the next task of a job, and removes the job from the queue once all of its tasks have been handed out. The lock must be held.
+			/// @param j The job.
+			/// @return The index of the task.
+			uint32_t take(job *j) const
+			{
+				const uint32_t i = j->next++;
+				if (j->next == j->count) { unlink(j); }
+				return i;
+			}
+
+			/// @brief Runs a task of a job without holding the lock.
+			/// @param lock The held lock.
+			/// @param j The job.
+			/// @param i The index of the task.
+			void run(std::unique_lock<std::mutex> &lock, job *j, uint32_t i) const
+			{
+				lock.unlock();
+				j->run(j->task, i);
+				lock.lock();
+				if (--j->remaining == 0) {
+					if (j->release != nullptr) {
+						lock.unlock();
+						j->release(j);
+						lock.lock();
+					} else {
+						m_done.notify_all();
+					}
+				}
+			}
+
+			/// @brief The main loop of each worker thread.
+			void work( void )
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				for (;;) {
+					if (m_head != nullptr) {
+						job *j = m_head;
+						run(lock, j, take(j));
+					} else if (m_quit) {
+						return;
+					} else {
+						m_wake.wait(lock);
+					}
+				}
+			}
+
+		public:
+			/// @brief Creates a new thread pool.
+			/// @param workers The number of worker threads to create in addition to the calling thread.
+			explicit thread_pool(uint32_t workers = std::thread::hardware_concurrency() > 1 ? std::thread::hardware_concurrency() - 1 : 0) : m_head(nullptr), m_quit(false)
+			{
+				m_threads.reserve(workers);
+				for (uint32_t i = 0; i < workers; ++i) {
+					m_threads.emplace_back(&thread_pool::work, this);
+				}
+			}
+
+			thread_pool(const thread_pool&) = delete;
+			thread_pool &operator=(const thread_pool&) = delete;
+
+			/// @brief Waits for all worker threads to exit.
+			~thread_pool( void )
+			{
+				{
+					std::lock_guard<std::mutex> lock(m_mutex);
+					m_quit = true;
+				}
+				m_wake.notify_all();
+				for (std::thread &t : m_threads) {
+					t.join();
+				}
+			}
+
+			/// @brief Returns the number of tasks that can run concurrently.
+			/// @return The number of worker threads plus the calling thread.
+			uint32_t size( void ) const { return uint32_t(m_threads.size()) + 1; }
+
+			/// @brief Runs tasks on the worker threads and the calling thread.
+			/// @tparam task_t The type of the task function/functor.
+			/// @param count The number of tasks to run.
+			/// @param task The task function/functor called with the index of each task. Must be safe to call from several threads at once.
+			/// @note Returns once all tasks have completed. Several threads may run tasks on the same pool at once.
+			template < typename task_t >
+			void operator()(uint32_t count, const task_t &task) const
+			{
+				if (count == 0) { return; }
+				job j = { &thread_pool::invoke<task_t>, &task, count, 0, count, nullptr, nullptr };
+				std::unique_lock<std::mutex> lock(m_mutex);
+				push(&j);
+				while (j.next < j.count) {
+					run(lock, &j, take(&j));
+				}
+				m_done.wait(lock, [&j]( void ) { return j.remaining == 0; });
+			}
+
+			/// @brief Queues tasks on the worker threads and returns without waiting for them to complete.
+			/// @tparam task_t The type of the task function/functor.
+			/// @param count The number of tasks to run.
+			/// @param task The task function/functor called with the index of each task. Copied into the pool and destroyed once all tasks have completed. Must be safe to call from several threads at once.
+			/// @note The tasks share the worker threads with every other call on the pool, so no thread is created. A pool without worker threads runs the tasks on the calling thread before returning.
+			template < typename task_t >
+			void submit(uint32_t count, const task_t &task) const
+			{
+				if (count == 0) { return; }
+				if (m_threads.empty()) {
+					for (uint32_t i = 0; i < count; ++i) { task(i); }
+					return;
+				}
+				job *j = new detached_job<task_t>(count, task);
+				std::lock_guard<std::mutex> lock(m_mutex);
+				push(j);
+			}
+		};
+
+		/// @brief Scales a source area across a destination area and applies a processor function on several threads by dividing the destination mask into one slab per thread along the outermost axis. Each thread processes its slab a chunk of slices at a time, and then steals chunks from the back of the slab with the most slices left. Suitable for processors whose cost varies a lot across the destination area.
+		/// @tparam processor_t The type of the processor function. Must be safe to call from several threads at once.
+		/// @tparam dimensions The number of dimensions of the space to iterate over.
+		/// @tparam fixed_t The fixed-point type of the source index.
+		/// @tparam executor_t The type of the executor running the worker loops.
+		/// @param dst_area The destination area to scale the source area over.
+		/// @param src_area The source area to scale over the destination area.
+		/// @param processor A function taking a destination index and a source index and performs computations.
+		/// @param dst_mask A mask used to discard all processing on the destination buffer that falls outside of the area.
+		/// @param executor The executor running one worker loop per concurrent task. Returns once the entire area has been processed.
+		/// @param grain The smallest number of elements taken or stolen at a time, rounded up to whole slices along the outermost axis.
+		/// @note Produces the same destination and source indices as scale with the same parameters.
+		/// @sa scale_parallel
+		template < typename processor_t, uint32_t dimensions, typename fixed_t, typename executor_t >
+		void scale_work_stealing(Area<int32_t,dimensions> dst_area, Area<fixed_t,dimensions> src_area, const processor_t &processor, Area<int32_t,dimensions> dst_mask, const executor_t &executor, uint64_t grain = 4096);
+
+		/// @brief For internal use only. Do not use.
+		namespace internal
+		{
+			/// @brief The progress of a call to scale_async, shared between its tasks and its handle.
+			/// @tparam dimensions The number of dimensions of the space to iterate over.
+			template < uint32_t dimensions >
+			class async_state
+			{
+			private:
+				Area<int32_t,dimensions>             m_clipped;   // The destination area clipped against the destination mask.
+				uint32_t                             m_count;     // The number of tiles.
+				std::unique_ptr<std::atomic<bool>[]> m_done;      // Determines if each tile has been processed.
+				std::mutex                           m_mutex;     // Guards m_remaining.
+				std::condition_variable              m_changed;   // Signals waiters that a tile has been processed.
+				uint32_t                             m_remaining; // The number of tiles not yet processed.
+
+			public:
+				/// @brief Creates a new state with no tiles processed.
+				/// @param clipped The destination area clipped against the destination mask.
+				/// @param count The number of tiles.
+				async_state(const Area<int32_t,dimensions> &clipped, uint32_t count) : m_clipped(clipped), m_count(count), m_done(new std::atomic<bool>[count > 0 ? count : 1]), m_remaining(count)
+				{
+					for (uint32_t i = 0; i < count; ++i) {
+						m_done[i] = false;
+					}
+				}
+
+				/// @brief Returns the number of tiles.
+				/// @return The number of tiles.
+				uint32_t count( void ) const { return m_count; }
+
+				/// @brief Returns a tile of the clipped destination area.
+				/// @param i The index of the tile.
+				/// @return The tile, a slab along the outermost axis.
+				Area<int32_t,dimensions> tile(uint32_t i) const
+				{
+					static constexpr uint32_t AXIS = dimensions - 1;
+					const int64_t length = m_clipped.b[AXIS] - m_clipped.a[AXIS];
+					Area<int32_t,dimensions> tile = m_clipped;
+					tile.a[AXIS] = m_clipped.a[AXIS] + int32_t(length * i / m_count);
+					tile.b[AXIS] = m_clipped.a[AXIS] + int32_t(length * (i + 1) / m_count);
+					return tile;
+				}
+
+				/// @brief Determines if a tile has been processed.
+				/// @param i The index of the tile.
+				/// @return True if the tile has been processed.
+				bool ready(uint32_t i) const { return m_done[i].load(std::memory_order_acquire); }
+
+				/// @brief Marks a tile as processed and wakes up any waiters.
+				/// @param i The index of the tile.
+				void finish(uint32_t i)
+				{
+					m_done[i].store(true, std::memory_order_release);
+					std::lock_guard<std::mutex> lock(m_mutex);
+					--m_remaining;
+					m_changed.notify_all();
+				}
+
+				/// @brief Waits for a tile to be processed.
+				/// @param i The index of the tile.
+				void wait(uint32_t i)
+				{
+					std::unique_lock<std::mutex> lock(m_mutex);
+					m_changed.wait(lock, [this, i]( void ) { return ready(i); });
+				}
+
+				/// @brief Waits for all tiles to be processed.
+				void wait( void )
+				{
+					std::unique_lock<std::mutex> lock(m_mutex);
+					m_changed.wait(lock, [this]( void ) { return m_remaining == 0; });
+				}
+			};
+
+			/// @brief A task processing one tile of a call to scale_async. Holds copies of the areas and the processor, since the caller does not wait for the tiles.
+			/// @tparam processor_t The type of the processor function/functor.
+			/// @tparam dimensions The number of dimensions of the space to iterate over.
+			/// @tparam fixed_t The fixed-point type of the source index.
+			template < typename processor_t, uint32_t dimensions, typename fixed_t >
+			class async_task
+			{
+			private:
+				Area<int32_t,dimensions>  m_dst_area;  // The destination area.
+				Area<fixed_t,dimensions>  m_src_area;  // The source area.
+				processor_t               m_processor; // The processor.
+				async_state<dimensions>  *m_state;     // The progress of the call.
+
+			public:
+				/// @brief Creates a new task.
+				/// @param dst_area The destination area.
+				/// @param src_area The source area.
+				/// @param processor The processor.
+				/// @param state The progress of the call.
+				async_task(const Area<int32_t,dimensions> &dst_area, const Area<fixed_t,dimensions> &src_area, const processor_t &processor, async_state<dimensions> *state) : m_dst_area(dst_area), m_src_area(src_area), m_processor(processor), m_state(state) {}
+
+				/// @brief Processes a tile and marks it as processed.
+				/// @param i The index of the tile.
+				void operator()(uint32_t i) const
+				{
+					static constexpr uint32_t AXIS = dimensions - 1;
+					const Area<int32_t,dimensions> tile = m_state->tile(i);
+					if (tile.a[AXIS] < tile.b[AXIS]) {
+						scale(m_dst_area, m_src_area, m_processor, tile);
+					}
+					m_state->finish(i);
+				}
+			};
+
+			/// @brief Determines at compile-time if an executor can queue tasks without waiting for them to complete, i.e. if it can be called as `executor.submit(count, task)`.
+			/// @tparam executor_t The type of the executor.
+			template < typename executor_t >
+			class has_submit
+			{
+			private:
+				template < typename type_t > static int16_t test(decltype(void(declval<const type_t&>().submit(uint32_t(0), declval<void(*const&)(uint32_t)>())))*);
+				template < typename type_t > static int8_t  test(...);
+
+			public:
+				static constexpr bool value = sizeof(test<executor_t>(nullptr)) == sizeof(int16_t); // True if the executor can queue tasks without waiting.
+			};
+
+			/// @brief Hands the tiles of a call to scale_async to an executor without blocking the caller.
+			/// @tparam submits True if the executor can queue tasks without waiting for them to complete.
+			template < bool submits >
+			struct async_submit
+			{
+				/// @brief Queues the tiles on the executor.
+				/// @tparam executor_t The type of the executor.
+				/// @tparam task_t The type of the task.
+				/// @param executor The executor.
+				/// @param count The number of tiles.
+				/// @param task The task processing a tile.
+				/// @return No thread, since the executor runs the tiles on its own threads.
+				template < typename executor_t, typename task_t >
+				static std::thread run(const executor_t &executor, uint32_t count, const task_t &task)
+				{
+					executor.submit(count, task);
+					return std::thread();
+				}
+			};
+
+			/// @brief Hands the tiles of a call to scale_async to an executor that only has a blocking call operator, by calling it from a new thread.
+			template <>
+			struct async_submit<false>
+			{
+				/// @brief Calls the executor from a new thread.
+				/// @tparam executor_t The type of the executor.
+				/// @tparam task_t The type of the task.
+				/// @param executor The executor.
+				/// @param count The number of tiles.
+				/// @param task The task processing a tile.
+				/// @return The thread calling the executor. Since the thread also takes part in running the tiles of executors such as thread_pool, it is one thread more than the executor reports.
+				template < typename executor_t, typename task_t >
+				static std::thread run(const executor_t &executor, uint32_t count, const task_t &task)
+				{
+					return std::thread([task, count, &executor]( void ) { executor(count, task); });
+				}
+			};
+		}
+
+		/// @brief A handle to a call to scale_async that can be polled or waited on, for the entire destination or one tile at a time. Waits for the call to complete when destroyed.
+		/// @tparam dimensions The number of dimensions of the space to iterate over.
+		/// @sa scale_async
+		template < uint32_t dimensions >
+		class scale_handle
+		{
+		private:
+			std::unique_ptr< internal::async_state<dimensions> > m_state;  // The progress of the call. Null if the handle has been moved from.
+			std::thread                                          m_thread; // The thread calling the executor, for executors that can not queue tasks without waiting.
+
+		public:
+			/// @brief Creates a handle to a call.
+			/// @param state The progress of the call.
+			/// @param thread The thread calling the executor, if any.
+			scale_handle(std::unique_ptr< internal::async_state<dimensions> > state, std::thread thread) : m_state(std::move(state)), m_thread(std::move(thread)) {}
+
+			scale_handle(scale_handle&&) = default;
+			scale_handle(const scale_handle&) = delete;
+			scale_handle &operator=(const scale_handle&) = delete;
+
+			/// @brief Waits for the call of this handle to complete, and then takes over the call of another handle.
+			/// @param other The handle to take over. Reads as a completed call with no tiles afterwards.
+			/// @return This handle.
+			scale_handle &operator=(scale_handle &&other)
+			{
+				if (this != &other) {
+					if (m_state) { m_state->wait(); }
+					if (m_thread.joinable()) { m_thread.join(); }
+					m_state = std::move(other.m_state);
+					m_thread = std::move(other.m_thread);
+				}
+				return *this;
+			}
+
+			/// @brief Waits for the call to complete.
+			~scale_handle( void )
+			{
+				if (m_state) { m_state->wait(); }
+				if (m_thread.joinable()) { m_thread.join(); }
+			}
+
+			/// @brief Returns the number of tiles the destination is processed in.
+			/// @return The number of tiles. 0 if the handle has been moved from.
+			uint32_t tiles( void ) const { return m_state ? m_state->count() : 0; }
+
+			/// @brief Returns the part of the destination processed by a tile.
+			/// @param i The index of the tile. Must be less than tiles().
+			/// @return The tile. Can be used as the destination mask of a dependent stage. An empty area if the handle has been moved from.
+			Area<int32_t,dimensions> tile(uint32_t i) const
+			{
+				if (m_state) { return m_state->tile(i); }
+				Area<int32_t,dimensions> empty;
+				for (uint32_t j = 0; j < dimensions; ++j) {
+					empty.a[j] = empty.b[j] = 0;
+				}
+				return empty;
+			}
+
+			/// @brief Determines if a tile has been processed, without blocking.
+			/// @param i The index of the tile.
+			/// @return True if every element of the tile has been written. True if the handle has been moved from.
+			bool ready(uint32_t i) const { return !m_state || m_state->ready(i); }
+
+			/// @brief Determines if all tiles have been processed, without blocking.
+			/// @return True if the call has completed. True if the handle has been moved from.
+			bool ready( void ) const
+			{
+				for (uint32_t i = 0; i < tiles(); ++i) {
+					if (!m_state->ready(i)) { return false; }
+				}
+				return true;
+			}
+
+			/// @brief Waits for a tile to be processed. Returns right away if the handle has been moved from.
+			/// @param i The index of the tile.
+			void wait(uint32_t i) const { if (m_state) { m_state->wait(i); } }
+
+			/// @brief Waits for all tiles to be processed. Returns right away if the handle has been moved from.
+			void wait( void ) const { if (m_state) { m_state->wait(); } }
+		};
+
+		/// @brief Scales a source area across a destination area and applies a processor function in the background, by dividing the destination mask into tiles along the outermost axis and handing them to an executor without waiting for them. Returns immediately with a handle that can be polled or waited on, either for the entire destination or for individual tiles, so that dependent stages can consume finished tiles before the rest of the destination is done.
+		/// @tparam processor_t The type of the processor function. Copied into the call. Must be safe to call from several threads at once if the executor runs tasks concurrently.
+		/// @tparam dimensions The number of dimensions of the space to iterate over.
+		/// @tparam fixed_t The fixed-point type of the source index.
+		/// @tparam executor_t The type of the executor running the tiles.
+		/// @param dst_area The destination area to scale the source area over.
+		/// @param src_area The source area to scale over the destination area.
+		/// @param processor A function taking a destination index and a source index and performs computations.
+		/// @param dst_mask A mask used to discard all processing on the destination buffer that falls outside of the area.
+		/// @param executor The executor running the tiles. Must outlive the call, as must the arrays the processor reads and writes.
+		/// @param tiles The number of tiles, or 0 for one per concurrent task of the executor. More tiles let dependent stages start sooner.
+		/// @return The handle. Waits for the call to complete when destroyed.
+		/// @note Executors with a `submit(count, task)` member function, such as thread_pool, queue the tiles on their own threads. Other executors are called from a new thread per call, which costs a thread creation and, for executors that also run tasks on the calling thread, one more running thread than the executor reports.
+		/// @note Produces the same destination and source indices as scale with the same parameters.
+		/// @sa scale_parallel
+		template < typename processor_t, uint32_t dimensions, typename fixed_t, typename executor_t >
+		scale_handle<dimensions> scale_async(Area<int32_t,dimensions> dst_area, Area<fixed_t,dimensions> src_area, const processor_t &processor, Area<int32_t,dimensions> dst_mask, const executor_t &executor, uint32_t tiles = 0);
+
+		/// @brief For internal use only. Do not use.
+		namespace internal
+		{
+			/// @brief The slices along the outermost axis left in the slab of a single worker of scale_work_stealing. The owner takes chunks from the front while other workers steal chunks from the back, both with a single compare-and-swap rather than a lock.
+			class stealing_range
+			{
+			private:
+				std::atomic<uint64_t> m_range;                                // The first slice in the low 32 bits and one past the last slice in the high 32 bits, relative to the start of the clipped destination area.
+				char                  m_pad[64 - sizeof(std::atomic<uint64_t>)]; // Keeps the ranges of different workers on different cache lines.
+
+			public:
+				/// @brief Creates an empty range.
+				stealing_range( void ) : m_range(0) {}
+
+				/// @brief Sets the range before any worker starts.
+				/// @param begin The first slice.
+				/// @param end One past the last slice.
+				void reset(uint32_t begin, uint32_t end) { m_range.store(uint64_t(begin) | (uint64_t(end) << 32), std::memory_order_relaxed); }
+
+				/// @brief Returns the number of slices left.
+				/// @return The number of slices.
+				uint32_t size( void ) const
+				{
+					const uint64_t range = m_range.load(std::memory_order_relaxed);
+					return uint32_t(range >> 32) - uint32_t(range);
+				}
+
+				/// @brief Removes a chunk of slices from the front of the range.
+				/// @param chunk The largest number of slices to remove.
+				/// @param begin Receives the first removed slice.
+				/// @param end Receives one past the last removed slice.
+				/// @return False if the range is empty.
+				bool take(uint32_t chunk, uint32_t &begin, uint32_t &end)
+				{
+					uint64_t range = m_range.load(std::memory_order_relaxed);
+					for (;;) {
+						const uint32_t a = uint32_t(range), b = uint32_t(range >> 32);
+						if (a >= b) { return false; }
+						const uint32_t n = b - a < chunk ? b - a : chunk;
+						if (m_range.compare_exchange_weak(range, uint64_t(a + n) | (uint64_t(b) << 32), std::memory_order_relaxed)) {
+							begin = a;
+							end = a + n;
+							return true;
+						}
+					}
+				}
+
+				/// @brief Removes a chunk of slices from the back of the range.
+				/// @param chunk The largest number of slices to remove.
+				/// @param begin Receives the first removed slice.
+				/// @param end Receives one past the last removed slice.
+				/// @return False if the range is empty.
+				bool steal(uint32_t chunk, uint32_t &begin, uint32_t &end)
+				{
+					uint64_t range = m_range.load(std::memory_order_relaxed);
+					for (;;) {
+						const uint32_t a = uint32_t(range), b = uint32_t(range >> 32);
+						if (a >= b) { return false; }
+						const uint32_t n = b - a < chunk ? b - a : chunk;
+						if (m_range.compare_exchange_weak(range, uint64_t(a) | (uint64_t(b - n) << 32), std::memory_order_relaxed)) {
+							begin = b - n;
+							end = b;
+							return true;
+						}
+					}
+				}
+			};
+
+			/// @brief The worker loop of scale_work_stealing.
+			/// @tparam processor_t The type of the processor function/functor.
+			/// @tparam dimensions The number of dimensions of the space to iterate over.
+			/// @tparam fixed_t The fixed-point type of the source index.
+			template < typename processor_t, uint32_t dimensions, typename fixed_t >
+			class stealing_task
+			{
+			private:
+				const Area<int32_t,dimensions> &m_dst_area;  // The destination area.
+				const Area<fixed_t,dimensions> &m_src_area;  // The source area.
+				const processor_t              &m_processor; // The processor.
+				const Area<int32_t,dimensions> &m_clipped;   // The destination area clipped against the destination mask.
+				stealing_range                 *m_ranges;    // The slices left to each worker.
+				uint32_t                        m_count;     // The number of workers.
+				uint32_t                        m_chunk;     // The number of slices taken or stolen at a time.
+
+			private:
+				/// @brief Steals a chunk from the worker with the most slices left.
+				/// @param worker The index of the stealing worker.
+				/// @param begin Receives the first stolen slice.
+				/// @param end Receives one past the last stolen slice.
+				/// @return False if no worker has any slices left.
+				bool steal(uint32_t worker, uint32_t &begin, uint32_t &end) const
+				{
+					for (;;) {
+						uint32_t victim = worker, most = 0;
+						for (uint32_t i = 1; i < m_count; ++i) {
+							const uint32_t j = (worker + i) % m_count, n = m_ranges[j].size();
+							if (n > most) {
+								victim = j;
+								most = n;
+							}
+						}
+						if (most == 0) { return false; }
+						if (m_ranges[victim].steal(m_chunk, begin, end)) { return true; }
+					}
+				}
+
+				/// @brief Processes a chunk of slices.
+				/// @param begin The first slice.
+				/// @param end One past the last slice.
+				void process(uint32_t begin, uint32_t end) const
+				{
+					static constexpr uint32_t AXIS = dimensions - 1;
+					Area<int32_t,dimensions> mask = m_clipped;
+					mask.a[AXIS] = int32_t(int64_t(m_clipped.a[AXIS]) + begin);
+					mask.b[AXIS] = int32_t(int64_t(m_clipped.a[AXIS]) + end);
+					scale(m_dst_area, m_src_area, m_processor, mask);
+				}
+
+			public:
+				/// @brief Creates a new task.
+				/// @param dst_area The destination area.
+				/// @param src_area The source area.
+				/// @param processor The processor.
+				/// @param clipped The destination area clipped against the destination mask.
+				/// @param ranges The slices left to each worker.
+				/// @param count The number of workers.
+				/// @param chunk The number of slices taken or stolen at a time.
+				stealing_task(const Area<int32_t,dimensions> &dst_area, const Area<fixed_t,dimensions> &src_area, const processor_t &processor, const Area<int32_t,dimensions> &clipped, stealing_range *ranges, uint32_t count, uint32_t chunk) : m_dst_area(dst_area), m_src_area(src_area), m_processor(processor), m_clipped(clipped), m_ranges(ranges), m_count(count), m_chunk(chunk) {}
+
+				/// @brief Processes chunks of its own slab, and then chunks stolen from other workers, until no worker has any slices left. Stolen chunks are processed right away rather than queued, so every slice not in a range is being processed, and the worker returns as soon as all ranges are empty without waiting on other workers, including those the executor has not started.
+				/// @param worker The index of the worker.
+				void operator()(uint32_t worker) const
+				{
+					uint32_t begin, end;
+					while (m_ranges[worker].take(m_chunk, begin, end) || steal(worker, begin, end)) {
+						process(begin, end);
+					}
+				}
+			};
+		}
+	}
+}
+
+template < typename processor_t, uint32_t dimensions, typename fixed_t, typename executor_t >
+void cc0::scale::scale_work_stealing(cc0::scale::Area<int32_t,dimensions> dst_area, cc0::scale::Area<fixed_t,dimensions> src_area, const processor_t &processor, cc0::scale::Area<int32_t,dimensions> dst_mask, const executor_t &executor, uint64_t grain)
+{
+	Area<int32_t,dimensions> clipped;
+	if (!internal::clip(dst_area, dst_mask, clipped)) {
+		scale(dst_area, src_area, processor, dst_mask); // Reports why nothing was processed.
+		return;
+	}
+	static constexpr uint32_t AXIS = dimensions - 1;
+	const uint32_t count  = executor.size() > 0 ? executor.size() : 1;
+	const uint32_t length = uint32_t(int64_t(clipped.b[AXIS]) - clipped.a[AXIS]);
+	uint64_t slice = 1;
+	for (uint32_t i = 0; i < AXIS; ++i) {
+		slice *= uint64_t(int64_t(clipped.b[i]) - clipped.a[i]);
+	}
+	const uint64_t chunk = grain > slice ? (grain + slice - 1) / slice : 1;
+	// Seed every worker with a slab along the outermost axis, so that progress never depends on a single worker starting.
+	std::vector<internal::stealing_range> ranges(count);
+	for (uint32_t i = 0; i < count; ++i) {
+		ranges[i].reset(uint32_t(uint64_t(length) * i / count), uint32_t(uint64_t(length) * (i + 1) / count));
+	}
+	executor(count, internal::stealing_task<processor_t,dimensions,fixed_t>(dst_area, src_area, processor, clipped, ranges.data(), count, uint32_t(internal::min(chunk, uint64_t(length)))));
+}
+
+template < typename processor_t, uint32_t dimensions, typename fixed_t, typename executor_t >
+cc0::scale::scale_handle<dimensions> cc0::scale::scale_async(cc0::scale::Area<int32_t,dimensions> dst_area, cc0::scale::Area<fixed_t,dimensions> src_area, const processor_t &processor, cc0::scale::Area<int32_t,dimensions> dst_mask, const executor_t &executor, uint32_t tiles)
+{
+	Area<int32_t,dimensions> clipped;
+	if (!internal::clip(dst_area, dst_mask, clipped)) {
+		scale(dst_area, src_area, processor, dst_mask); // Reports why nothing was processed.
+		return scale_handle<dimensions>(std::unique_ptr< internal::async_state<dimensions> >(new internal::async_state<dimensions>(clipped, 0)), std::thread());
+	}
+	const uint32_t length = uint32_t(clipped.b[dimensions - 1] - clipped.a[dimensions - 1]);
+	const uint32_t count  = internal::min(tiles > 0 ? tiles : (executor.size() > 0 ? executor.size() : 1), length);
+	std::unique_ptr< internal::async_state<dimensions> > state(new internal::async_state<dimensions>(clipped, count));
+	const internal::async_task<processor_t,dimensions,fixed_t> task(dst_area, src_area, processor, state.get());
+	std::thread thread = internal::async_submit< internal::has_submit<executor_t>::value >::run(executor, count, task);
+	return scale_handle<dimensions>(std::move(state), std::move(thread));
+}
+
+#endif